@@ -1,6 +1,9 @@
 #include <benchmark/benchmark.h>
 #include "geom_simd/clip.h"
+#include <cmath>
 #include <random>
+#include <string>
+#include <vector>
 
 using namespace geom;
 using namespace geom::intersect;
@@ -58,10 +61,115 @@ BENCHMARK(BM_EdgeIntersect_Scalar)
     ->Arg(4096)
     ->Unit(benchmark::kMicrosecond);
 
-#ifdef HAVE_AVX512
+// The ISA kernels fault on CPUs without them, so check before timing
+static bool skip_without(benchmark::State& state, bool available, const char* isa) {
+    if (!available) {
+        state.SkipWithError((std::string(isa) + " not available").c_str());
+    }
+    return !available;
+}
+
+// Benchmark SSE2 edge intersection, the floor for x86-64 hosts without AVX
+static void BM_EdgeIntersect_SSE2(benchmark::State& state) {
+    if (skip_without(state, get_simd_capabilities().sse2_available, "SSE2")) {
+        return;
+    }
+    size_t n_edges = state.range(0);
+    auto poly_b = generate_random_polygon(n_edges + 1);
+    
+    double ax1 = 0, ay1 = 0, ax2 = 50, ay2 = 50;
+    
+    for (auto _ : state) {
+        size_t intersection_count = 0;
+        EdgeIntersection results[2];
+        
+        size_t i = 0;
+        for (; i + 1 < n_edges; i += 2) {
+            edge_intersect_sse2({ax1, ay1}, {ax2, ay2}, poly_b, i, results);
+            intersection_count += results[0].intersects + results[1].intersects;
+        }
+        
+        for (; i < n_edges; ++i) {
+            auto result = edge_intersect_scalar(
+                {ax1, ay1}, {ax2, ay2},
+                {poly_b.x[i], poly_b.y[i]},
+                {poly_b.x[i+1], poly_b.y[i+1]}
+            );
+            
+            if (result.intersects) {
+                intersection_count++;
+            }
+        }
+        
+        benchmark::DoNotOptimize(intersection_count);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * n_edges);
+}
+BENCHMARK(BM_EdgeIntersect_SSE2)
+    ->Arg(64)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Arg(4096)
+    ->Unit(benchmark::kMicrosecond);
+
+// Benchmark AVX2 edge intersection
+static void BM_EdgeIntersect_AVX2(benchmark::State& state) {
+    if (skip_without(state, get_simd_capabilities().avx2_available, "AVX2")) {
+        return;
+    }
+    size_t n_edges = state.range(0);
+    auto poly_b = generate_random_polygon(n_edges + 1);
+    
+    double ax1 = 0, ay1 = 0, ax2 = 50, ay2 = 50;
+    
+    for (auto _ : state) {
+        size_t intersection_count = 0;
+        EdgeIntersection results[4];
+        
+        // Process 4 edges at a time
+        size_t i = 0;
+        for (; i + 3 < n_edges; i += 4) {
+            edge_intersect_avx2(ax1, ay1, ax2, ay2, poly_b, i, results);
+            
+            for (int j = 0; j < 4; ++j) {
+                if (results[j].intersects) {
+                    intersection_count++;
+                }
+            }
+        }
+        
+        // Handle remainder with scalar
+        for (; i < n_edges; ++i) {
+            auto result = edge_intersect_scalar(
+                {ax1, ay1}, {ax2, ay2},
+                {poly_b.x[i], poly_b.y[i]},
+                {poly_b.x[i+1], poly_b.y[i+1]}
+            );
+            
+            if (result.intersects) {
+                intersection_count++;
+            }
+        }
+        
+        benchmark::DoNotOptimize(intersection_count);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * n_edges);
+}
+BENCHMARK(BM_EdgeIntersect_AVX2)
+    ->Arg(64)
+    ->Arg(67)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Arg(4096)
+    ->Unit(benchmark::kMicrosecond);
 
 // Benchmark AVX-512 edge intersection
 static void BM_EdgeIntersect_AVX512(benchmark::State& state) {
+    if (skip_without(state, get_simd_capabilities().avx512_available, "AVX-512")) {
+        return;
+    }
     size_t n_edges = state.range(0);
     auto poly_b = generate_random_polygon(n_edges + 1);
     
@@ -103,13 +211,369 @@ static void BM_EdgeIntersect_AVX512(benchmark::State& state) {
     state.SetItemsProcessed(state.iterations() * n_edges);
 }
 BENCHMARK(BM_EdgeIntersect_AVX512)
+    ->Arg(64)
+    ->Arg(67)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Arg(1027)
+    ->Arg(4096)
+    ->Unit(benchmark::kMicrosecond);
+
+// Same sweep without the scalar remainder: the padded storage lets the last
+// partial block go through the kernel too, with the extra lanes ignored
+static void BM_EdgeIntersect_AVX512_Padded(benchmark::State& state) {
+    if (skip_without(state, get_simd_capabilities().avx512_available, "AVX-512")) {
+        return;
+    }
+    size_t n_edges = state.range(0);
+    auto poly_b = generate_random_polygon(n_edges + 1);
+    
+    // Test edge
+    double ax1 = 0, ay1 = 0, ax2 = 50, ay2 = 50;
+    
+    for (auto _ : state) {
+        size_t intersection_count = 0;
+        EdgeIntersection results[8];
+        
+        for (size_t i = 0; i < n_edges; i += 8) {
+            edge_intersect_avx512({ax1, ay1}, {ax2, ay2}, poly_b, i, results);
+            
+            size_t lanes = n_edges - i < 8 ? n_edges - i : 8;
+            for (size_t j = 0; j < lanes; ++j) {
+                if (results[j].intersects) {
+                    intersection_count++;
+                }
+            }
+        }
+        
+        benchmark::DoNotOptimize(intersection_count);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * n_edges);
+}
+BENCHMARK(BM_EdgeIntersect_AVX512_Padded)
+    ->Arg(64)
+    ->Arg(67)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Arg(1027)
+    ->Arg(4096)
+    ->Unit(benchmark::kMicrosecond);
+
+// Short polylines, where the remainder is most of the work. mode 0 finishes
+// with the scalar kernel, mode 1 with one masked call.
+static void BM_EdgeIntersect_AVX512_Tail(benchmark::State& state) {
+    if (skip_without(state, get_simd_capabilities().avx512_available, "AVX-512")) {
+        return;
+    }
+    size_t n_edges = state.range(0);
+    bool masked = state.range(1) != 0;
+    
+    // Many short polylines so the working set isn't a single line in L1
+    constexpr size_t kLines = 256;
+    std::vector<PolylineSoA> lines;
+    for (size_t k = 0; k < kLines; ++k) {
+        lines.push_back(generate_random_polygon(n_edges + 1, static_cast<unsigned>(k)));
+    }
+    
+    // Test edge
+    double ax1 = 0, ay1 = 0, ax2 = 50, ay2 = 50;
+    
+    for (auto _ : state) {
+        size_t intersection_count = 0;
+        EdgeIntersection results[8];
+        
+        for (const auto& poly_b : lines) {
+            size_t i = 0;
+            for (; i + 7 < n_edges; i += 8) {
+                edge_intersect_avx512({ax1, ay1}, {ax2, ay2}, poly_b, i, results);
+                for (int j = 0; j < 8; ++j) {
+                    intersection_count += results[j].intersects;
+                }
+            }
+            
+            if (masked) {
+                if (i < n_edges) {
+                    edge_intersect_avx512_masked({ax1, ay1}, {ax2, ay2}, poly_b, i, n_edges - i, results);
+                    for (int j = 0; j < 8; ++j) {
+                        intersection_count += results[j].intersects;
+                    }
+                }
+            } else {
+                for (; i < n_edges; ++i) {
+                    auto result = edge_intersect_scalar(
+                        {ax1, ay1}, {ax2, ay2},
+                        {poly_b.x[i], poly_b.y[i]},
+                        {poly_b.x[i+1], poly_b.y[i+1]}
+                    );
+                    intersection_count += result.intersects;
+                }
+            }
+        }
+        
+        benchmark::DoNotOptimize(intersection_count);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * kLines * n_edges);
+    state.SetLabel(masked ? "masked" : "scalar tail");
+}
+BENCHMARK(BM_EdgeIntersect_AVX512_Tail)
+    ->ArgsProduct({{3, 5, 7, 11, 15, 31}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Cost of going through edge_intersect_range()'s dispatch table.
+// Arg 1: 0 = AVX-512 kernels called directly, 1 = edge_intersect_range() per
+// 8 edges (one indirect call per block, the worst case), 2 = one
+// edge_intersect_range() call for the whole polyline.
+static void BM_EdgeIntersect_Dispatch(benchmark::State& state) {
+    if (skip_without(state, get_simd_capabilities().avx512_available, "AVX-512")) {
+        return;
+    }
+    size_t n_edges = state.range(0);
+    const int mode = static_cast<int>(state.range(1));
+    auto poly_b = generate_random_polygon(n_edges + 1);
+    std::vector<EdgeIntersection> results(n_edges + 8);
+    
+    // Test edge
+    Point a1{0, 0}, a2{50, 50};
+    
+    for (auto _ : state) {
+        if (mode == 0) {
+            size_t i = 0;
+            for (; i + 8 <= n_edges; i += 8) {
+                edge_intersect_avx512(a1, a2, poly_b, i, &results[i]);
+            }
+            if (i < n_edges) {
+                edge_intersect_avx512_masked(a1, a2, poly_b, i, n_edges - i, &results[i]);
+            }
+        } else if (mode == 1) {
+            for (size_t i = 0; i < n_edges; i += 8) {
+                edge_intersect_range(a1, a2, poly_b, i, n_edges - i < 8 ? n_edges - i : 8, &results[i]);
+            }
+        } else {
+            edge_intersect_range(a1, a2, poly_b, 0, n_edges, results.data());
+        }
+        
+        size_t intersection_count = 0;
+        for (size_t i = 0; i < n_edges; ++i) {
+            intersection_count += results[i].intersects;
+        }
+        benchmark::DoNotOptimize(intersection_count);
+    }
+    
+    static const char* const kLabels[] = {"direct", "range per block", "range per line"};
+    state.SetLabel(kLabels[mode]);
+    state.SetItemsProcessed(state.iterations() * n_edges);
+}
+BENCHMARK(BM_EdgeIntersect_Dispatch)
+    ->ArgsProduct({{8, 64, 1024}, {0, 1, 2}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Whole-polyline sweep, writing every result vs appending only the hits.
+// Arg 1: 0 = edge_intersect_range() into one EdgeIntersection per edge,
+// 1 = edge_intersect_batch() into reused SoA columns.
+static void BM_EdgeIntersect_Batch(benchmark::State& state) {
+    size_t n_edges = state.range(0);
+    const bool batch = state.range(1) != 0;
+    auto poly_b = generate_random_polygon(n_edges + 1);
+    std::vector<EdgeIntersection> results(n_edges);
+    EdgeHitsSoA hits;
+    
+    // A short test edge crosses about 1% of the ring, the long one about 20%
+    const double extent = static_cast<double>(state.range(2));
+    Point a1{0, 0}, a2{extent, extent};
+    
+    for (auto _ : state) {
+        size_t intersection_count = 0;
+        if (batch) {
+            hits.clear();
+            intersection_count = edge_intersect_batch(a1, a2, poly_b, 0, n_edges, hits);
+        } else {
+            edge_intersect_range(a1, a2, poly_b, 0, n_edges, results.data());
+            for (size_t i = 0; i < n_edges; ++i) {
+                intersection_count += results[i].intersects;
+            }
+        }
+        benchmark::DoNotOptimize(intersection_count);
+    }
+    
+    state.SetLabel(batch ? "batch" : "range");
+    state.SetItemsProcessed(state.iterations() * n_edges);
+}
+BENCHMARK(BM_EdgeIntersect_Batch)
+    ->ArgsProduct({{64, 1024, 16384}, {0, 1}, {2, 50}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Same sweep on float coordinates, 16 edges per call
+static void BM_EdgeIntersect_AVX512_F32(benchmark::State& state) {
+    if (skip_without(state, get_simd_capabilities().avx512_available, "AVX-512")) {
+        return;
+    }
+    size_t n_edges = state.range(0);
+    auto poly_d = generate_random_polygon(n_edges + 1);
+    PolylineSoAf poly_b;
+    for (size_t i = 0; i < poly_d.size(); ++i) {
+        poly_b.push_back(static_cast<float>(poly_d.x[i]), static_cast<float>(poly_d.y[i]));
+    }
+    
+    // Test edge
+    double ax1 = 0, ay1 = 0, ax2 = 50, ay2 = 50;
+    
+    for (auto _ : state) {
+        size_t intersection_count = 0;
+        EdgeIntersection results[16];
+        
+        size_t i = 0;
+        for (; i + 15 < n_edges; i += 16) {
+            edge_intersect_avx512({ax1, ay1}, {ax2, ay2}, poly_b, i, results);
+            
+            for (int j = 0; j < 16; ++j) {
+                if (results[j].intersects) {
+                    intersection_count++;
+                }
+            }
+        }
+        
+        // Handle remainder with scalar
+        for (; i < n_edges; ++i) {
+            auto result = edge_intersect_scalar(
+                {ax1, ay1}, {ax2, ay2},
+                {poly_b.x[i], poly_b.y[i]},
+                {poly_b.x[i+1], poly_b.y[i+1]}
+            );
+            
+            if (result.intersects) {
+                intersection_count++;
+            }
+        }
+        
+        benchmark::DoNotOptimize(intersection_count);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * n_edges);
+    state.counters["bytes"] = static_cast<double>(2 * poly_b.size() * sizeof(float));
+}
+BENCHMARK(BM_EdgeIntersect_AVX512_F32)
     ->Arg(64)
     ->Arg(256)
     ->Arg(1024)
     ->Arg(4096)
     ->Unit(benchmark::kMicrosecond);
 
-#endif // HAVE_AVX512
+// The same float sweep on AVX2, 8 edges per call
+static void BM_EdgeIntersect_AVX2_F32(benchmark::State& state) {
+    if (skip_without(state, get_simd_capabilities().avx2_available, "AVX2")) {
+        return;
+    }
+    size_t n_edges = state.range(0);
+    auto poly_d = generate_random_polygon(n_edges + 1);
+    PolylineSoAf poly_b;
+    for (size_t i = 0; i < poly_d.size(); ++i) {
+        poly_b.push_back(static_cast<float>(poly_d.x[i]), static_cast<float>(poly_d.y[i]));
+    }
+    
+    // Test edge
+    double ax1 = 0, ay1 = 0, ax2 = 50, ay2 = 50;
+    
+    for (auto _ : state) {
+        size_t intersection_count = 0;
+        EdgeIntersection results[8];
+        
+        size_t i = 0;
+        for (; i + 7 < n_edges; i += 8) {
+            edge_intersect_avx2({ax1, ay1}, {ax2, ay2}, poly_b, i, results);
+            
+            for (int j = 0; j < 8; ++j) {
+                if (results[j].intersects) {
+                    intersection_count++;
+                }
+            }
+        }
+        
+        // Handle remainder with scalar
+        for (; i < n_edges; ++i) {
+            auto result = edge_intersect_scalar(
+                {ax1, ay1}, {ax2, ay2},
+                {poly_b.x[i], poly_b.y[i]},
+                {poly_b.x[i+1], poly_b.y[i+1]}
+            );
+            
+            if (result.intersects) {
+                intersection_count++;
+            }
+        }
+        
+        benchmark::DoNotOptimize(intersection_count);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * n_edges);
+    state.counters["bytes"] = static_cast<double>(2 * poly_b.size() * sizeof(float));
+}
+BENCHMARK(BM_EdgeIntersect_AVX2_F32)
+    ->Arg(64)
+    ->Arg(256)
+    ->Arg(1024)
+    ->Arg(4096)
+    ->Unit(benchmark::kMicrosecond);
+
+// Fixed-point kernels on a 4096 x 4096 tile grid.
+// Arg 0: edges. Arg 1: 0 = scalar, 1 = AVX2 (4 edges/call), 2 = AVX-512 (8 edges/call).
+static void BM_EdgeIntersect_Int32(benchmark::State& state) {
+    size_t n_edges = state.range(0);
+    auto poly_d = generate_random_polygon(n_edges + 1);
+    PolylineSoAi poly_b;
+    for (size_t i = 0; i < poly_d.size(); ++i) {
+        poly_b.push_back(static_cast<int32_t>((poly_d.x[i] + 100.0) * 20.0),
+                         static_cast<int32_t>((poly_d.y[i] + 100.0) * 20.0));
+    }
+    
+    // Test edge
+    PointI a1{2000, 2000}, a2{3000, 3000};
+    const int mode = static_cast<int>(state.range(1));
+    auto caps = get_simd_capabilities();
+    if ((mode == 1 && skip_without(state, caps.avx2_available, "AVX2")) ||
+        (mode == 2 && skip_without(state, caps.avx512_available, "AVX-512"))) {
+        return;
+    }
+    
+    for (auto _ : state) {
+        size_t intersection_count = 0;
+        EdgeIntersection results[8];
+        size_t i = 0;
+        
+        if (mode == 1) {
+            for (; i + 3 < n_edges; i += 4) {
+                edge_intersect_avx2_i32(a1, a2, poly_b, i, results);
+                for (int j = 0; j < 4; ++j) {
+                    intersection_count += results[j].intersects ? 1 : 0;
+                }
+            }
+        }
+        if (mode == 2) {
+            for (; i + 7 < n_edges; i += 8) {
+                edge_intersect_avx512_i32(a1, a2, poly_b, i, results);
+                for (int j = 0; j < 8; ++j) {
+                    intersection_count += results[j].intersects ? 1 : 0;
+                }
+            }
+        }
+        
+        // Scalar mode, or the remainder
+        for (; i < n_edges; ++i) {
+            auto result = edge_intersect_scalar_i32(a1, a2, {poly_b.x[i], poly_b.y[i]},
+                                                    {poly_b.x[i+1], poly_b.y[i+1]});
+            intersection_count += result.intersects ? 1 : 0;
+        }
+        
+        benchmark::DoNotOptimize(intersection_count);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * n_edges);
+    state.counters["bytes"] = static_cast<double>(2 * poly_b.size() * sizeof(int32_t));
+}
+BENCHMARK(BM_EdgeIntersect_Int32)
+    ->ArgsProduct({{64, 1024, 4096}, {0, 1, 2}})
+    ->Unit(benchmark::kMicrosecond);
 
 // Benchmark full N×M intersection finding (realistic use case)
 static void BM_AllIntersections_Scalar(benchmark::State& state) {
@@ -149,9 +613,10 @@ BENCHMARK(BM_AllIntersections_Scalar)
     ->Arg(128)
     ->Unit(benchmark::kMicrosecond);
 
-#ifdef HAVE_AVX512
-
 static void BM_AllIntersections_AVX512(benchmark::State& state) {
+    if (skip_without(state, get_simd_capabilities().avx512_available, "AVX-512")) {
+        return;
+    }
     size_t n = state.range(0);
     auto poly_a = generate_random_polygon(n, 42);
     auto poly_b = generate_random_polygon(n, 123);
@@ -205,6 +670,83 @@ BENCHMARK(BM_AllIntersections_AVX512)
     ->Arg(128)
     ->Unit(benchmark::kMicrosecond);
 
-#endif // HAVE_AVX512
+// Closed ring with a jagged radius, like a simplified coastline
+Polygon generate_ring(size_t n_vertices, double cx, double cy, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> jitter(-5.0, 5.0);
+    
+    Polygon ring;
+    for (size_t i = 0; i < n_vertices; ++i) {
+        double angle = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(n_vertices);
+        double radius = 100.0 + jitter(rng);
+        ring.vertices.push_back(cx + radius * std::cos(angle), cy + radius * std::sin(angle));
+    }
+    ring.close();
+    return ring;
+}
+
+// End to end find_all_intersections() on two overlapping rings.
+// Arg 0: vertices per ring. Arg 1: SimplifyAlgorithm (0 = AUTO, 1 = SCALAR).
+static void BM_FindAllIntersections(benchmark::State& state) {
+    size_t n = state.range(0);
+    auto algo = static_cast<SimplifyAlgorithm>(state.range(1));
+    auto a = generate_ring(n, 0.0, 0.0, 42);
+    auto b = generate_ring(n, 60.0, 25.0, 123);
+    
+    size_t hits = 0;
+    for (auto _ : state) {
+        auto result = find_all_intersections(a, b, algo);
+        hits = result.size();
+        benchmark::DoNotOptimize(result.data());
+    }
+    
+    state.counters["hits"] = static_cast<double>(hits);
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_FindAllIntersections)
+    ->ArgsProduct({
+        benchmark::CreateRange(64, 65536, 4),
+        {static_cast<int>(SimplifyAlgorithm::SCALAR),
+         static_cast<int>(SimplifyAlgorithm::AUTO)}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Full N×M sweep over the edges of two ring outlines, without culling.
+// Arg 1: 0 = one edge_intersect_batch() per edge of A (the per-edge loop),
+// 1 = the register-tiled polyline find_all_intersections().
+static void BM_AllIntersections_Tiled(benchmark::State& state) {
+    size_t n = state.range(0);
+    const bool tiled = state.range(1) != 0;
+    PolylineSoA a = generate_ring(n, 0.0, 0.0, 42).vertices;
+    PolylineSoA b = generate_ring(n, 60.0, 25.0, 123).vertices;
+    EdgeHitsSoA batch;
+    
+    size_t hits = 0;
+    for (auto _ : state) {
+        if (tiled) {
+            auto result = find_all_intersections(a, b);
+            hits = result.size();
+            benchmark::DoNotOptimize(result.data());
+        } else {
+            std::vector<EdgeHit> result;
+            for (size_t i = 0; i + 1 < a.size(); ++i) {
+                Point a1{a.x[i], a.y[i]}, a2{a.x[i + 1], a.y[i + 1]};
+                batch.clear();
+                edge_intersect_batch(a1, a2, b, 0, b.size() - 1, batch);
+                for (size_t k = 0; k < batch.size(); ++k) {
+                    result.push_back({i, batch.edge[k], batch.t[k], batch.u[k], batch.x[k], batch.y[k]});
+                }
+            }
+            hits = result.size();
+            benchmark::DoNotOptimize(result.data());
+        }
+    }
+    
+    state.counters["hits"] = static_cast<double>(hits);
+    state.SetLabel(tiled ? "tiled" : "per-edge");
+    state.SetItemsProcessed(state.iterations() * (n - 1) * (n - 1));
+}
+BENCHMARK(BM_AllIntersections_Tiled)
+    ->ArgsProduct({{128, 1024, 4096, 16384}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
 
 BENCHMARK_MAIN();
@@ -1,9 +1,54 @@
 #include <benchmark/benchmark.h>
 #include "geom_simd/geom_simd.h"
+#include "geom_simd/streaming.h"
 #include "test_data.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <queue>
+#include <string>
+#include <type_traits>
 
 using namespace geom;
 
+// Count heap allocations so the allocation benchmarks can report them per call.
+// GCC can't tell the replaced operator new is malloc-backed and warns on every
+// inlined delete otherwise.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace {
+std::atomic<size_t> g_allocations{0};
+}
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+// PolylineSoA storage goes through the aligned forms
+void* operator new(size_t size, std::align_val_t align) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    size_t alignment = static_cast<size_t>(align);
+    if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
 // Benchmark fixture for different line sizes
 class SimplifyFixture : public benchmark::Fixture {
 public:
@@ -119,6 +164,138 @@ BENCHMARK_REGISTER_F(SimplifyFixture, Auto_SineWave)
     ->Range(64, 16384)
     ->Unit(benchmark::kMicrosecond);
 
+// AVX2 implementation benchmarks, one per dataset so the speedup over the
+// matching Scalar_* fixture is visible directly
+BENCHMARK_DEFINE_F(SimplifyFixture, Avx2_Random)(benchmark::State& state) {
+    if (!get_simd_capabilities().avx2_available) {
+        state.SkipWithError("AVX2 not available");
+        return;
+    }
+    for (auto _ : state) {
+        auto result = simplify(test_line, 1.0, SimplifyAlgorithm::AVX2);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * test_line.size());
+}
+BENCHMARK_REGISTER_F(SimplifyFixture, Avx2_Random)
+    ->RangeMultiplier(4)
+    ->Range(64, 16384)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(SimplifyFixture, Avx2_SineWave)(benchmark::State& state) {
+    if (!get_simd_capabilities().avx2_available) {
+        state.SkipWithError("AVX2 not available");
+        return;
+    }
+    for (auto _ : state) {
+        auto result = simplify(sine_wave, 1.0, SimplifyAlgorithm::AVX2);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * sine_wave.size());
+}
+BENCHMARK_REGISTER_F(SimplifyFixture, Avx2_SineWave)
+    ->RangeMultiplier(4)
+    ->Range(64, 16384)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(SimplifyFixture, Avx2_Noisy)(benchmark::State& state) {
+    if (!get_simd_capabilities().avx2_available) {
+        state.SkipWithError("AVX2 not available");
+        return;
+    }
+    for (auto _ : state) {
+        auto result = simplify(noisy_line, 1.0, SimplifyAlgorithm::AVX2);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * noisy_line.size());
+}
+BENCHMARK_REGISTER_F(SimplifyFixture, Avx2_Noisy)
+    ->RangeMultiplier(4)
+    ->Range(64, 16384)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(SimplifyFixture, Avx2_Coastline)(benchmark::State& state) {
+    if (!get_simd_capabilities().avx2_available) {
+        state.SkipWithError("AVX2 not available");
+        return;
+    }
+    for (auto _ : state) {
+        auto result = simplify(coastline, 1.0, SimplifyAlgorithm::AVX2);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * coastline.size());
+}
+BENCHMARK_REGISTER_F(SimplifyFixture, Avx2_Coastline)
+    ->RangeMultiplier(4)
+    ->Range(64, 16384)
+    ->Unit(benchmark::kMicrosecond);
+
+// AVX-512 implementation benchmarks. Avx512_Random is the case the in-register
+// argmax targets: random data keeps most points, so the max scan dominates
+BENCHMARK_DEFINE_F(SimplifyFixture, Avx512_Random)(benchmark::State& state) {
+    if (!get_simd_capabilities().avx512_available) {
+        state.SkipWithError("AVX512 not available");
+        return;
+    }
+    for (auto _ : state) {
+        auto result = simplify(test_line, 1.0, SimplifyAlgorithm::AVX512);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * test_line.size());
+}
+BENCHMARK_REGISTER_F(SimplifyFixture, Avx512_Random)
+    ->RangeMultiplier(4)
+    ->Range(64, 16384)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(SimplifyFixture, Avx512_SineWave)(benchmark::State& state) {
+    if (!get_simd_capabilities().avx512_available) {
+        state.SkipWithError("AVX512 not available");
+        return;
+    }
+    for (auto _ : state) {
+        auto result = simplify(sine_wave, 1.0, SimplifyAlgorithm::AVX512);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * sine_wave.size());
+}
+BENCHMARK_REGISTER_F(SimplifyFixture, Avx512_SineWave)
+    ->RangeMultiplier(4)
+    ->Range(64, 16384)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(SimplifyFixture, Avx512_Noisy)(benchmark::State& state) {
+    if (!get_simd_capabilities().avx512_available) {
+        state.SkipWithError("AVX512 not available");
+        return;
+    }
+    for (auto _ : state) {
+        auto result = simplify(noisy_line, 1.0, SimplifyAlgorithm::AVX512);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * noisy_line.size());
+}
+BENCHMARK_REGISTER_F(SimplifyFixture, Avx512_Noisy)
+    ->RangeMultiplier(4)
+    ->Range(64, 16384)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(SimplifyFixture, Avx512_Coastline)(benchmark::State& state) {
+    if (!get_simd_capabilities().avx512_available) {
+        state.SkipWithError("AVX512 not available");
+        return;
+    }
+    for (auto _ : state) {
+        auto result = simplify(coastline, 1.0, SimplifyAlgorithm::AVX512);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * coastline.size());
+}
+BENCHMARK_REGISTER_F(SimplifyFixture, Avx512_Coastline)
+    ->RangeMultiplier(4)
+    ->Range(64, 16384)
+    ->Unit(benchmark::kMicrosecond);
+
 // Tolerance variation benchmarks
 static void BM_SimplifyTolerance(benchmark::State& state) {
     auto line = benchmark_data::generate_random_line(1000);
@@ -134,6 +311,580 @@ BENCHMARK(BM_SimplifyTolerance)
     ->DenseRange(0, 3)  // Tolerance from 1.0 to 0.001
     ->Unit(benchmark::kMicrosecond);
 
+// Pathological split depth ~n. The work is O(n^2) no matter what, this just
+// checks that the explicit work stack handles it without call overhead
+static void BM_DeepSplit(benchmark::State& state) {
+    auto line = benchmark_data::generate_growing_zigzag(state.range(0));
+    auto algo = static_cast<SimplifyAlgorithm>(state.range(1));
+    
+    auto caps = get_simd_capabilities();
+    if ((algo == SimplifyAlgorithm::SSE2 && !caps.sse2_available) ||
+        (algo == SimplifyAlgorithm::AVX2 && !caps.avx2_available) ||
+        (algo == SimplifyAlgorithm::AVX512 && !caps.avx512_available)) {
+        state.SkipWithError("ISA not available");
+        return;
+    }
+    
+    for (auto _ : state) {
+        auto result = simplify(line, 1.0, algo);
+        benchmark::DoNotOptimize(result);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_DeepSplit)
+    ->ArgsProduct({
+        {1024, 4096, 16384},
+        {static_cast<int>(SimplifyAlgorithm::SCALAR),
+         static_cast<int>(SimplifyAlgorithm::SSE2),
+         static_cast<int>(SimplifyAlgorithm::AVX2),
+         static_cast<int>(SimplifyAlgorithm::AVX512)}})
+    ->Unit(benchmark::kMillisecond);
+
+// Every point survives a tiny tolerance, so the split tree goes all the way
+// down and most find_farthest calls see segments shorter than a vector.
+// Measures how short segments finish (masked tails vs a scalar remainder).
+static void BM_ShortSegments(benchmark::State& state) {
+    const size_t num_lines = 256;
+    auto algo = static_cast<SimplifyAlgorithm>(state.range(1));
+    
+    auto caps = get_simd_capabilities();
+    if ((algo == SimplifyAlgorithm::SSE2 && !caps.sse2_available) ||
+        (algo == SimplifyAlgorithm::AVX2 && !caps.avx2_available) ||
+        (algo == SimplifyAlgorithm::AVX512 && !caps.avx512_available)) {
+        state.SkipWithError("ISA not available");
+        return;
+    }
+    
+    std::vector<PolylineSoA> lines;
+    for (size_t i = 0; i < num_lines; ++i) {
+        lines.push_back(benchmark_data::generate_random_line(state.range(0), 100.0, static_cast<unsigned>(i)));
+    }
+    
+    PolylineSoA output;
+    SimplifyScratch scratch;
+    
+    for (auto _ : state) {
+        for (const auto& line : lines) {
+            simplify_into(line, 1e-9, output, scratch, algo);
+            benchmark::DoNotOptimize(output.x.data());
+        }
+    }
+    
+    state.SetItemsProcessed(state.iterations() * num_lines * state.range(0));
+}
+BENCHMARK(BM_ShortSegments)
+    ->ArgsProduct({
+        {16, 64, 256},
+        {static_cast<int>(SimplifyAlgorithm::SCALAR),
+         static_cast<int>(SimplifyAlgorithm::SSE2),
+         static_cast<int>(SimplifyAlgorithm::AVX2),
+         static_cast<int>(SimplifyAlgorithm::AVX512)}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Many small polylines, the case where per-call malloc traffic dominates.
+// Arg 1 selects simplify_into with a reused output and scratch.
+static void BM_SmallLinesAllocations(benchmark::State& state) {
+    const size_t num_lines = 1024;
+    const bool reuse = state.range(1) != 0;
+    
+    std::vector<PolylineSoA> lines;
+    for (size_t i = 0; i < num_lines; ++i) {
+        lines.push_back(benchmark_data::generate_coastline(state.range(0), static_cast<unsigned>(i)));
+    }
+    
+    PolylineSoA output;
+    SimplifyScratch scratch;
+    size_t allocations = 0;
+    
+    for (auto _ : state) {
+        size_t before = g_allocations.load(std::memory_order_relaxed);
+        for (const auto& line : lines) {
+            if (reuse) {
+                simplify_into(line, 1.0, output, scratch);
+                benchmark::DoNotOptimize(output.x.data());
+            } else {
+                auto result = simplify(line, 1.0);
+                benchmark::DoNotOptimize(result);
+            }
+        }
+        allocations += g_allocations.load(std::memory_order_relaxed) - before;
+    }
+    
+    state.SetLabel(reuse ? "simplify_into" : "simplify");
+    state.SetItemsProcessed(state.iterations() * num_lines);
+    state.counters["allocs_per_call"] = benchmark::Counter(
+        static_cast<double>(allocations) / static_cast<double>(state.iterations() * num_lines));
+}
+BENCHMARK(BM_SmallLinesAllocations)
+    ->ArgsProduct({{16, 64, 256}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// AUTO over many lines of one size, with the default profile (arg 1 = 0,
+// widest ISA always) or one from calibrate_dispatch() (arg 1 = 1)
+static void BM_AutoDispatch(benchmark::State& state) {
+    static const DispatchProfile calibrated = calibrate_dispatch();
+    const size_t num_lines = 256;
+    const bool use_calibrated = state.range(1) != 0;
+
+    std::vector<PolylineSoA> lines;
+    for (size_t i = 0; i < num_lines; ++i) {
+        lines.push_back(benchmark_data::generate_coastline(state.range(0), static_cast<unsigned>(i)));
+    }
+
+    set_dispatch_profile(use_calibrated ? calibrated : DispatchProfile{});
+
+    PolylineSoA output;
+    SimplifyScratch scratch;
+    for (auto _ : state) {
+        for (const auto& line : lines) {
+            simplify_into(line, 1.0, output, scratch);
+            benchmark::DoNotOptimize(output.x.data());
+        }
+    }
+
+    set_dispatch_profile(DispatchProfile{});
+
+    state.SetLabel(use_calibrated ? "calibrated" : "default");
+    state.counters["avx512_min_points"] = static_cast<double>(calibrated.avx512_min_points);
+    state.SetItemsProcessed(state.iterations() * num_lines);
+}
+BENCHMARK(BM_AutoDispatch)
+    ->ArgsProduct({{5, 16, 48, 256, 4096}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Batch simplification of a tile's worth of lines at 1..16 threads.
+// Sizes are skewed (mostly short roads, a few long coastlines) so load
+// balancing by point count matters.
+static void BM_SimplifyBatch(benchmark::State& state) {
+    const size_t num_threads = state.range(0);
+    
+    std::vector<PolylineSoA> lines;
+    size_t total_points = 0;
+    for (size_t i = 0; i < 20000; ++i) {
+        size_t n = (i % 1000 == 0) ? 50000 : 16 + (i * 7919) % 240;
+        lines.push_back(benchmark_data::generate_coastline(n, static_cast<unsigned>(i)));
+        total_points += n;
+    }
+    
+    std::vector<PolylineSoA> outputs;
+    for (auto _ : state) {
+        simplify_batch(lines, outputs, 1.0, SimplifyAlgorithm::AUTO, num_threads);
+        benchmark::DoNotOptimize(outputs.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * total_points);
+}
+BENCHMARK(BM_SimplifyBatch)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// One huge line (country border / lidar profile scale) at 1..16 threads.
+// Arg 0 is the serial baseline.
+static void BM_SimplifyParallel(benchmark::State& state) {
+    static const PolylineSoA line = benchmark_data::generate_coastline(1 << 22);
+    
+    SimplifyOptions options;
+    if (state.range(0) > 0) {
+        options.execution = SimplifyExecution::PARALLEL;
+        options.num_threads = state.range(0);
+    }
+    
+    for (auto _ : state) {
+        auto result = simplify(line, 1.0, options);
+        benchmark::DoNotOptimize(result);
+    }
+    
+    state.SetItemsProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_SimplifyParallel)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Depth-first vs level-synchronous splitting on a noisy line, which breaks
+// into many segments too short to fill a vector.
+// Arg 1: 0 = SERIAL, 1 = BREADTH_FIRST. Arg 2: algorithm.
+static void BM_BreadthFirst(benchmark::State& state) {
+    auto line = benchmark_data::generate_noisy_line(state.range(0));
+    
+    SimplifyOptions options;
+    options.algorithm = static_cast<SimplifyAlgorithm>(state.range(2));
+    if (state.range(1) != 0) {
+        options.execution = SimplifyExecution::BREADTH_FIRST;
+    }
+    
+    auto caps = get_simd_capabilities();
+    if ((options.algorithm == SimplifyAlgorithm::AVX2 && !caps.avx2_available) ||
+        (options.algorithm == SimplifyAlgorithm::AVX512 && !caps.avx512_available)) {
+        state.SkipWithError("ISA not available");
+        return;
+    }
+    
+    PolylineSoA output;
+    SimplifyScratch scratch;
+    for (auto _ : state) {
+        simplify_into(line, 0.1, output, scratch, options);
+        benchmark::DoNotOptimize(output.x.data());
+    }
+    
+    state.SetLabel(state.range(1) != 0 ? "breadth_first" : "serial");
+    state.SetItemsProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_BreadthFirst)
+    ->ArgsProduct({{4096, 65536, 1 << 20},
+                   {0, 1},
+                   {static_cast<int>(SimplifyAlgorithm::SCALAR),
+                    static_cast<int>(SimplifyAlgorithm::AVX2),
+                    static_cast<int>(SimplifyAlgorithm::AVX512)}})
+    ->Unit(benchmark::kMicrosecond);
+
+// End-to-end simplify() with and without the radial pre-pass, 1M points.
+// Arg 0: 0 = noisy line, 1 = coastline. Arg 1: 0 = plain, 1 = pre-pass.
+// Arg 2: algorithm.
+static void BM_RadialPrefilter(benchmark::State& state) {
+    static const PolylineSoA noisy = benchmark_data::generate_noisy_line(1 << 20);
+    static const PolylineSoA coast = benchmark_data::generate_coastline(1 << 20);
+    const PolylineSoA& line = state.range(0) != 0 ? coast : noisy;
+    
+    SimplifyOptions options;
+    options.algorithm = static_cast<SimplifyAlgorithm>(state.range(2));
+    options.radial_prefilter = state.range(1) != 0;
+    
+    auto caps = get_simd_capabilities();
+    if ((options.algorithm == SimplifyAlgorithm::AVX2 && !caps.avx2_available) ||
+        (options.algorithm == SimplifyAlgorithm::AVX512 && !caps.avx512_available)) {
+        state.SkipWithError("ISA not available");
+        return;
+    }
+    
+    PolylineSoA output;
+    SimplifyScratch scratch;
+    for (auto _ : state) {
+        simplify_into(line, 2.0, output, scratch, options);
+        benchmark::DoNotOptimize(output.x.data());
+    }
+    
+    state.SetLabel(std::string(state.range(0) != 0 ? "coastline" : "noisy") +
+                   (options.radial_prefilter ? "/prefilter" : "/plain"));
+    state.counters["kept"] = static_cast<double>(output.size());
+    state.SetItemsProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_RadialPrefilter)
+    ->ArgsProduct({{0, 1},
+                   {0, 1},
+                   {static_cast<int>(SimplifyAlgorithm::SCALAR),
+                    static_cast<int>(SimplifyAlgorithm::AVX2),
+                    static_cast<int>(SimplifyAlgorithm::AVX512)}})
+    ->Unit(benchmark::kMillisecond);
+
+// Double vs float vs fixed-point Douglas-Peucker on the standard datasets,
+// 1M points. Fixed-point runs on the data snapped to a 1/16 grid, with the
+// tolerance scaled to match.
+// Arg 0: 0 = random, 1 = sine, 2 = noisy, 3 = coastline.
+// Arg 1: 0 = PolylineSoA, 1 = PolylineSoAf, 2 = PolylineSoAi. Arg 2: algorithm.
+template <typename T>
+BasicPolylineSoA<T> convert_line(const PolylineSoA& line, double scale) {
+    BasicPolylineSoA<T> out;
+    out.reserve(line.size());
+    for (size_t i = 0; i < line.size(); ++i) {
+        if constexpr (std::is_integral_v<T>) {
+            out.push_back(static_cast<T>(std::lround(line.x[i] * scale)),
+                          static_cast<T>(std::lround(line.y[i] * scale)));
+        } else {
+            out.push_back(static_cast<T>(line.x[i] * scale), static_cast<T>(line.y[i] * scale));
+        }
+    }
+    return out;
+}
+
+template <typename T>
+void run_precision(benchmark::State& state, const PolylineSoA& source, SimplifyAlgorithm algorithm) {
+    const double scale = std::is_integral_v<T> ? 16.0 : 1.0;
+    auto line = convert_line<T>(source, scale);
+    BasicPolylineSoA<T> output;
+    SimplifyScratch scratch;
+    for (auto _ : state) {
+        simplify_into(line, 0.5 * scale, output, scratch, algorithm);
+        benchmark::DoNotOptimize(output.x.data());
+    }
+    
+    state.counters["input_bytes"] = static_cast<double>(2 * line.size() * sizeof(T));
+    state.counters["kept"] = static_cast<double>(output.size());
+    state.SetBytesProcessed(state.iterations() * 2 * line.size() * sizeof(T));
+}
+
+static void BM_Precision(benchmark::State& state) {
+    static const PolylineSoA datasets[] = {
+        benchmark_data::generate_random_line(1 << 20),
+        benchmark_data::generate_sine_wave(1 << 20),
+        benchmark_data::generate_noisy_line(1 << 20),
+        benchmark_data::generate_coastline(1 << 20),
+    };
+    static const char* names[] = {"random", "sine", "noisy", "coastline"};
+    static const char* types[] = {"/f64", "/f32", "/i32"};
+    const PolylineSoA& source = datasets[state.range(0)];
+    auto algorithm = static_cast<SimplifyAlgorithm>(state.range(2));
+    
+    auto caps = get_simd_capabilities();
+    if ((algorithm == SimplifyAlgorithm::AVX2 && !caps.avx2_available) ||
+        (algorithm == SimplifyAlgorithm::AVX512 && !caps.avx512_available)) {
+        state.SkipWithError("ISA not available");
+        return;
+    }
+    
+    switch (state.range(1)) {
+        case 0: run_precision<double>(state, source, algorithm); break;
+        case 1: run_precision<float>(state, source, algorithm); break;
+        default: run_precision<int32_t>(state, source, algorithm); break;
+    }
+    state.SetLabel(std::string(names[state.range(0)]) + types[state.range(1)]);
+    state.SetItemsProcessed(state.iterations() * source.size());
+}
+BENCHMARK(BM_Precision)
+    ->ArgsProduct({{0, 1, 2, 3},
+                   {0, 1, 2},
+                   {static_cast<int>(SimplifyAlgorithm::SCALAR),
+                    static_cast<int>(SimplifyAlgorithm::AVX2),
+                    static_cast<int>(SimplifyAlgorithm::AVX512)}})
+    ->Unit(benchmark::kMillisecond);
+
+// Zoom pyramid: 15 tolerances on the same line. Arg 0 re-runs simplify()
+// per tolerance, arg 1 computes significance once and filters per tolerance.
+static void BM_ZoomPyramid(benchmark::State& state) {
+    auto line = benchmark_data::generate_coastline(state.range(0));
+    const bool precomputed = state.range(1) != 0;
+    
+    std::vector<double> tolerances;
+    for (int zoom = 0; zoom < 15; ++zoom) {
+        tolerances.push_back(0.05 * std::pow(2.0, zoom * 0.5));
+    }
+    
+    PolylineSoA output;
+    SimplifyScratch scratch;
+    for (auto _ : state) {
+        if (precomputed) {
+            auto significance = simplify_significance(line);
+            for (double tolerance : tolerances) {
+                simplify_by_significance(line, significance, tolerance, output);
+                benchmark::DoNotOptimize(output.x.data());
+            }
+        } else {
+            for (double tolerance : tolerances) {
+                simplify_into(line, tolerance, output, scratch);
+                benchmark::DoNotOptimize(output.x.data());
+            }
+        }
+    }
+    
+    state.SetLabel(precomputed ? "significance" : "simplify");
+    state.SetItemsProcessed(state.iterations() * line.size() * tolerances.size());
+}
+BENCHMARK(BM_ZoomPyramid)
+    ->ArgsProduct({{4096, 65536, 1 << 20}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+// The per-zoom cost once significance is known: one compare-and-compress pass
+static void BM_SignificanceFilter(benchmark::State& state) {
+    auto line = benchmark_data::generate_coastline(1 << 20);
+    auto significance = simplify_significance(line);
+    auto algo = static_cast<SimplifyAlgorithm>(state.range(0));
+    
+    auto caps = get_simd_capabilities();
+    if ((algo == SimplifyAlgorithm::SSE2 && !caps.sse2_available) ||
+        (algo == SimplifyAlgorithm::AVX2 && !caps.avx2_available) ||
+        (algo == SimplifyAlgorithm::AVX512 && !caps.avx512_available)) {
+        state.SkipWithError("ISA not available");
+        return;
+    }
+    
+    PolylineSoA output;
+    for (auto _ : state) {
+        simplify_by_significance(line, significance, 1.0, output, algo);
+        benchmark::DoNotOptimize(output.x.data());
+    }
+    
+    state.SetItemsProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_SignificanceFilter)
+    ->Arg(static_cast<int>(SimplifyAlgorithm::SCALAR))
+    ->Arg(static_cast<int>(SimplifyAlgorithm::SSE2))
+    ->Arg(static_cast<int>(SimplifyAlgorithm::AVX2))
+    ->Arg(static_cast<int>(SimplifyAlgorithm::AVX512))
+    ->Unit(benchmark::kMicrosecond);
+
+namespace {
+
+// Textbook Visvalingam-Whyatt: std::priority_queue with lazy deletion (stale
+// entries are skipped on pop) and scalar areas. Baseline for simplify_vw().
+PolylineSoA naive_vw(const PolylineSoA& line, double area_tolerance) {
+    size_t n = line.size();
+    auto area = [&](size_t a, size_t b, size_t c) {
+        double cross = (line.x[b] - line.x[a]) * (line.y[c] - line.y[a]) -
+                       (line.y[b] - line.y[a]) * (line.x[c] - line.x[a]);
+        return 0.5 * std::fabs(cross);
+    };
+
+    std::vector<size_t> prev(n), next(n);
+    std::vector<double> effective(n);
+    std::vector<bool> removed(n, false);
+    using Item = std::pair<double, size_t>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+
+    for (size_t i = 0; i < n; ++i) {
+        prev[i] = i - 1;
+        next[i] = i + 1;
+    }
+    for (size_t i = 1; i + 1 < n; ++i) {
+        effective[i] = area(i - 1, i, i + 1);
+        queue.push({effective[i], i});
+    }
+
+    while (!queue.empty()) {
+        Item item = queue.top();
+        queue.pop();
+        if (removed[item.second] || item.first != effective[item.second]) {
+            continue;
+        }
+        if (item.first >= area_tolerance) {
+            break;
+        }
+
+        size_t i = item.second;
+        removed[i] = true;
+        size_t p = prev[i], q = next[i];
+        next[p] = q;
+        prev[q] = p;
+        if (p != 0) {
+            effective[p] = std::max(area(prev[p], p, q), item.first);
+            queue.push({effective[p], p});
+        }
+        if (q != n - 1) {
+            effective[q] = std::max(area(p, q, next[q]), item.first);
+            queue.push({effective[q], q});
+        }
+    }
+
+    PolylineSoA result;
+    for (size_t i = 0; i < n; i = next[i]) {
+        result.push_back(line.x[i], line.y[i]);
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+// Visvalingam-Whyatt against Douglas-Peucker on the same coastline.
+// Arg 1: 0 = simplify() DP, 1 = simplify_vw(), 2 = naive priority_queue VW
+static void BM_Visvalingam(benchmark::State& state) {
+    auto line = benchmark_data::generate_coastline(state.range(0));
+    const int mode = static_cast<int>(state.range(1));
+    
+    size_t kept = 0;
+    for (auto _ : state) {
+        PolylineSoA result;
+        switch (mode) {
+            case 0: result = simplify(line, 1.0); break;
+            case 1: result = simplify_vw(line, 1.0); break;
+            default: result = naive_vw(line, 1.0); break;
+        }
+        kept = result.size();
+        benchmark::DoNotOptimize(result);
+    }
+    
+    const char* labels[] = {"dp", "vw", "vw_naive"};
+    state.SetLabel(labels[mode]);
+    state.counters["kept"] = static_cast<double>(kept);
+    state.SetItemsProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_Visvalingam)
+    ->ArgsProduct({{4096, 65536, 1 << 20}, {0, 1, 2}})
+    ->Unit(benchmark::kMicrosecond);
+
+// One live trace at a time, points/s per core. Arg 0 = chunk size fed to
+// push_many() (1 = push() per point), arg 1 = algorithm.
+static void BM_StreamingSingleTrace(benchmark::State& state) {
+    auto trace = benchmark_data::generate_coastline(1 << 20);
+    const size_t chunk = static_cast<size_t>(state.range(0));
+    auto algo = static_cast<SimplifyAlgorithm>(state.range(1));
+    
+    auto caps = get_simd_capabilities();
+    if ((algo == SimplifyAlgorithm::SSE2 && !caps.sse2_available) ||
+        (algo == SimplifyAlgorithm::AVX2 && !caps.avx2_available) ||
+        (algo == SimplifyAlgorithm::AVX512 && !caps.avx512_available)) {
+        state.SkipWithError("ISA not available");
+        return;
+    }
+    
+    StreamingSimplifier simplifier(1.0, algo);
+    PolylineSoA output;
+    output.reserve(trace.size());
+    for (auto _ : state) {
+        output.clear();
+        if (chunk == 1) {
+            for (size_t i = 0; i < trace.size(); ++i) {
+                simplifier.push(trace.x[i], trace.y[i], output);
+            }
+        } else {
+            for (size_t i = 0; i < trace.size(); i += chunk) {
+                size_t count = std::min(chunk, trace.size() - i);
+                simplifier.push_many(&trace.x[i], &trace.y[i], count, output);
+            }
+        }
+        simplifier.flush(output);
+        benchmark::DoNotOptimize(output.x.data());
+    }
+    
+    state.counters["kept"] = static_cast<double>(output.size());
+    state.SetItemsProcessed(state.iterations() * trace.size());
+}
+BENCHMARK(BM_StreamingSingleTrace)
+    ->ArgsProduct({{1, 64, 1024},
+                   {static_cast<int>(SimplifyAlgorithm::SCALAR),
+                    static_cast<int>(SimplifyAlgorithm::AVX2),
+                    static_cast<int>(SimplifyAlgorithm::AVX512)}})
+    ->Unit(benchmark::kMillisecond);
+
+// Many concurrent traces fed round-robin, one point each per tick, the way a
+// live ingest sees them. Arg 0 = number of open traces.
+static void BM_StreamingConcurrentTraces(benchmark::State& state) {
+    const size_t traces = static_cast<size_t>(state.range(0));
+    const size_t ticks = 64;
+    
+    // Each trace walks its own stretch of one long coastline
+    auto source = benchmark_data::generate_coastline(traces + ticks);
+    std::vector<StreamingSimplifier> simplifiers(traces, StreamingSimplifier(1.0));
+    PolylineSoA output;
+    output.reserve(traces * ticks);
+    
+    for (auto _ : state) {
+        output.clear();
+        for (size_t t = 0; t < ticks; ++t) {
+            for (size_t k = 0; k < traces; ++k) {
+                simplifiers[k].push(source.x[k + t], source.y[k + t], output);
+            }
+        }
+        for (auto& simplifier : simplifiers) {
+            simplifier.flush(output);
+        }
+        benchmark::DoNotOptimize(output.x.data());
+    }
+    
+    state.counters["state_bytes"] = static_cast<double>(sizeof(StreamingSimplifier) * traces);
+    state.SetItemsProcessed(state.iterations() * traces * ticks);
+}
+BENCHMARK(BM_StreamingConcurrentTraces)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+
 // Comparison benchmark showing speedup
 static void BM_CompareImplementations(benchmark::State& state) {
     auto line = benchmark_data::generate_random_line(1000);
@@ -154,6 +905,10 @@ static void BM_CompareImplementations(benchmark::State& state) {
         state.SkipWithError("NEON not available");
         return;
     }
+    if (algo == SimplifyAlgorithm::SSE2 && !caps.sse2_available) {
+        state.SkipWithError("SSE2 not available");
+        return;
+    }
     
     for (auto _ : state) {
         auto result = simplify(line, 1.0, algo);
@@ -164,6 +919,9 @@ static void BM_CompareImplementations(benchmark::State& state) {
 }
 BENCHMARK(BM_CompareImplementations)
     ->Arg(static_cast<int>(SimplifyAlgorithm::SCALAR))
+    ->Arg(static_cast<int>(SimplifyAlgorithm::SSE2))
+    ->Arg(static_cast<int>(SimplifyAlgorithm::AVX2))
+    ->Arg(static_cast<int>(SimplifyAlgorithm::AVX512))
     ->Arg(static_cast<int>(SimplifyAlgorithm::AUTO))
     ->Unit(benchmark::kMicrosecond);
 
@@ -88,5 +88,23 @@ inline PolylineSoA generate_coastline(size_t num_points, unsigned seed = 42) {
     return line;
 }
 
+/**
+ * Generate a worst case for Douglas-Peucker: a zigzag whose amplitude grows
+ * with x. For any chord the farthest point is always the one just before the
+ * end, so every split peels off a single point and the split depth is ~n.
+ */
+inline PolylineSoA generate_growing_zigzag(size_t num_points) {
+    PolylineSoA line;
+    line.reserve(num_points);
+    
+    for (size_t i = 0; i < num_points; ++i) {
+        double x = static_cast<double>(i);
+        double y = (i % 2 == 0) ? x : -x;
+        line.push_back(x, y);
+    }
+    
+    return line;
+}
+
 } // namespace benchmark_data
 } // namespace geom
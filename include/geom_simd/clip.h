@@ -72,17 +72,134 @@ EdgeIntersection edge_intersect_scalar(
     const Point& b1, const Point& b2
 );
 
-#ifdef HAVE_AVX512
+/**
+ * Exact edge-edge intersection on fixed-point coordinates.
+ *
+ * Same parametrization as edge_intersect_scalar(), but the cross products
+ * are exact 64-bit integers and the [0, 1] range checks compare numerators
+ * against the denominator, so there is no epsilon and no rounding in the
+ * decision: touching endpoints always count, and only exactly parallel
+ * edges are rejected. t, u and the point are computed in double for hits.
+ *
+ * Coordinates must lie in [-2^30, 2^30).
+ */
+EdgeIntersection edge_intersect_scalar_i32(
+    const PointI& a1, const PointI& a2,
+    const PointI& b1, const PointI& b2
+);
+
+/**
+ * Test one edge against edges [start_idx, start_idx+count) of b_vertices
+ * with the widest kernel this CPU supports, picked once per process.
+ * Ranges shorter than DispatchProfile::intersect_simd_min_edges use the
+ * scalar loop instead.
+ *
+ * @param a1, a2 The single edge to test
+ * @param b_vertices Vertices of polygon B (at least start_idx+count+1)
+ * @param start_idx First edge to test
+ * @param count Number of edges to test
+ * @param results Output array of count EdgeIntersection results
+ *
+ * Results match edge_intersect_scalar() bit for bit on every edge, on any
+ * CPU: every kernel does the same unfused multiplies and subtracts, so
+ * pairs that touch at an endpoint are decided the same way everywhere.
+ * Nothing past b_vertices[start_idx+count] is read.
+ */
+void edge_intersect_range(
+    const Point& a1, const Point& a2,
+    const PolylineSoA& b_vertices,
+    size_t start_idx,
+    size_t count,
+    EdgeIntersection* results
+);
+
+/**
+ * Single-precision edge_intersect_range(). The AVX2 and AVX-512 kernels work
+ * in float throughout and agree with each other; other CPUs fall back to
+ * edge_intersect_scalar() on the widened coordinates, so hits within float
+ * rounding of an edge end can differ between machines.
+ */
+void edge_intersect_range(
+    const Point& a1, const Point& a2,
+    const PolylineSoAf& b_vertices,
+    size_t start_idx,
+    size_t count,
+    EdgeIntersection* results
+);
+
+/**
+ * Fixed-point edge_intersect_range(). Every kernel is exact, so results
+ * match edge_intersect_scalar_i32() on any CPU.
+ */
+void edge_intersect_range(
+    const PointI& a1, const PointI& a2,
+    const PolylineSoAi& b_vertices,
+    size_t start_idx,
+    size_t count,
+    EdgeIntersection* results
+);
+
+/**
+ * Hits from edge_intersect_batch(), one column per field. Only the first
+ * size() rows are hits: the columns are grown ahead of each batch (the
+ * kernels store whole vectors) and never shrunk, so a reused EdgeHitsSoA
+ * stops allocating once it has seen the largest batch.
+ */
+struct EdgeHitsSoA {
+    AlignedVector<double> t;     // Parameter along the tested edge [0,1]
+    AlignedVector<double> u;     // Parameter along the B edge [0,1]
+    AlignedVector<double> x;     // Intersection point
+    AlignedVector<double> y;
+    AlignedVector<size_t> edge;  // Index of the B edge in b_vertices
+    size_t count = 0;
+    
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() { count = 0; }
+};
+
+/**
+ * Test one edge against edges [start_idx, start_idx+count) of b_vertices,
+ * like edge_intersect_range(), but append only the hits to out, in edge
+ * order. Output writes scale with the number of hits instead of count,
+ * which is what sparse workloads want.
+ *
+ * @return Number of hits appended
+ *
+ * Same kernel choice as edge_intersect_range(), and the same unfused
+ * arithmetic, so each hit is edge_intersect_scalar()'s bit for bit on any
+ * CPU, touching endpoints included. Nothing past
+ * b_vertices[start_idx+count] is read.
+ */
+size_t edge_intersect_batch(
+    const Point& a1, const Point& a2,
+    const PolylineSoA& b_vertices,
+    size_t start_idx,
+    size_t count,
+    EdgeHitsSoA& out
+);
+
+/*
+ * Fixed-width kernels for one ISA each. They are declared in every build,
+ * but may only be called when get_simd_capabilities() reports their ISA:
+ * on other CPUs they fault, and in builds without that ISA's kernels they
+ * throw std::runtime_error. edge_intersect_range() does the check for you.
+ */
+
 /**
  * Test one edge against 8 edges simultaneously (AVX-512 implementation)
  * 
  * Tests if edge A intersects with any of 8 edges from polygon B.
  * 
  * @param a1, a2 The single edge to test
- * @param b_vertices Vertices of polygon B (should have at least start_idx+9 vertices)
+ * @param b_vertices Vertices of polygon B
  * @param start_idx Starting index in b_vertices (will test edges [start_idx, start_idx+8))
  * @param results Output array of 8 EdgeIntersection results
  * 
+ * PolylineSoA storage is padded (see AlignedAllocator), so start_idx may be
+ * any vertex: a block that runs past the last edge reads padding, and the
+ * results for edges past b_vertices.size() - 2 are unspecified.
+ *
  * Note: Each edge is formed by (b_vertices[i], b_vertices[i+1])
  *       So we test against edges:
  *         [start_idx -> start_idx+1]
@@ -96,11 +213,54 @@ void edge_intersect_avx512(
     size_t start_idx,
     EdgeIntersection results[8]
 );
-#endif
 
-#ifdef HAVE_AVX2
+/**
+ * Tail-safe edge_intersect_avx512(): tests edges [start_idx, start_idx+count)
+ * for count <= 8 with masked loads, so nothing past b_vertices[start_idx+count]
+ * is read. results[count..7] report no intersection.
+ *
+ * Lets a sweep finish its last partial block in vector code on any storage.
+ */
+void edge_intersect_avx512_masked(
+    const Point& a1, const Point& a2,
+    const PolylineSoA& b_vertices,
+    size_t start_idx,
+    size_t count,
+    EdgeIntersection results[8]
+);
+
+/**
+ * Single-precision edge_intersect_avx512(): one edge against 16 edges of a
+ * float polyline, computed in float throughout.
+ *
+ * @param a1, a2 The single edge to test (rounded to float)
+ * @param b_vertices Vertices of polygon B (should have at least start_idx+17 vertices)
+ * @param start_idx Starting index in b_vertices (will test edges [start_idx, start_idx+16))
+ * @param results Output array of 16 EdgeIntersection results
+ */
+void edge_intersect_avx512(
+    const Point& a1, const Point& a2,
+    const PolylineSoAf& b_vertices,
+    size_t start_idx,
+    EdgeIntersection results[16]
+);
+
+/**
+ * Fixed-point edge_intersect_scalar_i32() against 8 edges of b_vertices,
+ * [start_idx, start_idx+8), with 64-bit products in integer lanes.
+ */
+void edge_intersect_avx512_i32(
+    const PointI& a1, const PointI& a2,
+    const PolylineSoAi& b_vertices,
+    size_t start_idx,
+    EdgeIntersection results[8]
+);
+
 /**
  * AVX2 version - tests one edge against 4 edges simultaneously
+ *
+ * Same math as edge_intersect_avx512() at 4 lanes. Tests edges
+ * [start_idx, start_idx+4), reading up to b_vertices[start_idx+4].
  */
 void edge_intersect_avx2(
     double ax1, double ay1, double ax2, double ay2,
@@ -108,11 +268,50 @@ void edge_intersect_avx2(
     size_t start_idx,
     EdgeIntersection results[4]
 );
-#endif
 
-#ifdef HAVE_NEON
 /**
- * ARM NEON version - tests one edge against 2 edges simultaneously
+ * Single-precision edge_intersect_avx2(): one edge against 8 edges of a
+ * float polyline, computed in float throughout like the AVX-512 version.
+ *
+ * @param a1, a2 The single edge to test (rounded to float)
+ * @param b_vertices Vertices of polygon B (should have at least start_idx+9 vertices)
+ * @param start_idx Starting index in b_vertices (will test edges [start_idx, start_idx+8))
+ * @param results Output array of 8 EdgeIntersection results
+ */
+void edge_intersect_avx2(
+    const Point& a1, const Point& a2,
+    const PolylineSoAf& b_vertices,
+    size_t start_idx,
+    EdgeIntersection results[8]
+);
+
+/**
+ * Fixed-point edge_intersect_scalar_i32() against 4 edges of b_vertices,
+ * [start_idx, start_idx+4), with 64-bit products in integer lanes.
+ */
+void edge_intersect_avx2_i32(
+    const PointI& a1, const PointI& a2,
+    const PolylineSoAi& b_vertices,
+    size_t start_idx,
+    EdgeIntersection results[4]
+);
+
+/**
+ * SSE2 version, the x86-64 baseline - tests edge A against the 2 edges of
+ * b_vertices [start_idx, start_idx+2), reading b_vertices[start_idx+2] at
+ * most.
+ */
+void edge_intersect_sse2(
+    const Point& a1, const Point& a2,
+    const PolylineSoA& b_vertices,
+    size_t start_idx,
+    EdgeIntersection results[2]
+);
+
+/**
+ * ARM NEON version - tests edge A against the 2 edges of b_vertices
+ * [start_idx, start_idx+2). NEON builds currently run the scalar kernel
+ * here; other builds throw std::runtime_error.
  */
 void edge_intersect_neon(
     double ax1, double ay1, double ax2, double ay2,
@@ -120,7 +319,19 @@ void edge_intersect_neon(
     size_t start_idx,
     EdgeIntersection results[2]
 );
-#endif
+
+/**
+ * One crossing between two polygons' edges. Edge i of a polygon runs from
+ * vertex i to vertex i+1; an open ring's closing edge (last vertex back to
+ * the first) is edge size()-1.
+ */
+struct EdgeHit {
+    size_t a_edge;       // Edge index in the first polygon
+    size_t b_edge;       // Edge index in the second polygon
+    double t;            // Parameter along a_edge [0,1]
+    double u;            // Parameter along b_edge [0,1]
+    double x, y;         // Intersection point
+};
 
 /**
  * Find all intersections between two polygons
@@ -128,15 +339,40 @@ void edge_intersect_neon(
  * @param a First polygon
  * @param b Second polygon
  * @param algorithm Which SIMD implementation to use
- * @return Vector of all intersection points with edge indices
+ * @return Every crossing, ordered by a_edge then b_edge
+ * @throws std::runtime_error if the requested ISA is not available
  * 
- * This will use the fastest available SIMD implementation.
+ * AUTO uses the fastest available SIMD implementation. Each edge of A is
+ * tested against B in blocks of edges, skipping blocks whose bounding box
+ * it misses; every back end keeps exactly the pairs edge_intersect_scalar()
+ * accepts, with its t, u and point bit for bit (see edge_intersect_range()).
  */
-std::vector<EdgeIntersection> find_all_intersections(
+std::vector<EdgeHit> find_all_intersections(
     const Polygon& a,
     const Polygon& b,
     SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO
 );
 
+/**
+ * Find all intersections between the edges of two polylines
+ *
+ * @param a First polyline; edge i runs from vertex i to vertex i+1
+ * @param b Second polyline
+ * @param algorithm Which SIMD implementation to use
+ * @return Every crossing, ordered by a_edge then b_edge
+ * @throws std::runtime_error if the requested ISA is not available
+ *
+ * Tests all n x m edge pairs, with no bounding-box culling, so it suits
+ * dense or small inputs. The SIMD kernels keep a tile of B edges in
+ * registers while streaming edges of A past it, in cache-sized blocks of
+ * both. As with the polygon version, hits are edge_intersect_scalar()'s bit
+ * for bit on every back end.
+ */
+std::vector<EdgeHit> find_all_intersections(
+    const PolylineSoA& a,
+    const PolylineSoA& b,
+    SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO
+);
+
 } // namespace intersect
 } // namespace geom
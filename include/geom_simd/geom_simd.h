@@ -1,6 +1,11 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace geom {
@@ -14,15 +19,83 @@ struct Point {
     Point(double x_, double y_) : x(x_), y(y_) {}
 };
 
-struct PolylineSoA {
-    std::vector<double> x;
-    std::vector<double> y;
+/// A 2D point on an integer grid (fixed-point coordinates)
+struct PointI {
+    int32_t x;
+    int32_t y;
+
+    PointI() : x(0), y(0) {}
+    PointI(int32_t x_, int32_t y_) : x(x_), y(y_) {}
+};
+
+/// Alignment of PolylineSoA storage, and how far past the last element a
+/// full-width vector load may reach
+constexpr size_t kSimdAlignment = 64;
+
+/**
+ * Allocator for SoA coordinate arrays.
+ *
+ * Storage is 64-byte aligned, so data() starts on a cache line and block
+ * i * (64 / sizeof(T)) can use aligned loads of any width. Every allocation
+ * is also padded to a whole number of 64-byte blocks plus one more block,
+ * so a full-width load (up to 512 bits) starting at any element stays inside
+ * it. The padding's contents are unspecified: kernels that read it must mask
+ * those lanes off.
+ */
+template <typename T>
+struct AlignedAllocator {
+    using value_type = T;
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        // Rounding up and the extra block add at most 2 * kSimdAlignment bytes
+        if (n > (SIZE_MAX - 2 * kSimdAlignment) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        size_t bytes = (n * sizeof(T) + kSimdAlignment - 1) / kSimdAlignment * kSimdAlignment;
+        return static_cast<T*>(::operator new(bytes + kSimdAlignment,
+                                              std::align_val_t{kSimdAlignment}));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(p, std::align_val_t{kSimdAlignment});
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U>&) const noexcept { return false; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+/**
+ * Polyline stored as separate x and y arrays, so SIMD kernels can load a
+ * full vector of either coordinate with one contiguous load.
+ *
+ * T is the coordinate type: double (PolylineSoA), float (PolylineSoAf) or
+ * int32_t (PolylineSoAi). Floats halve the memory traffic and double the
+ * lanes per vector, and are plenty for tile-local coordinates. int32 is for
+ * data already snapped to a grid (e.g. 4096 x 4096 vector tiles): its
+ * kernels are exact, with no epsilons.
+ */
+template <typename T>
+struct BasicPolylineSoA {
+    using value_type = T;
+
+    // Aligned and padded, see AlignedAllocator
+    AlignedVector<T> x;
+    AlignedVector<T> y;
 
     // default constructor
-    PolylineSoA() = default;
+    BasicPolylineSoA() = default;
 
     // point list initializer for tests
-    PolylineSoA(std::initializer_list<std::pair<double, double>> points) {
+    BasicPolylineSoA(std::initializer_list<std::pair<T, T>> points) {
         x.reserve(points.size());
         y.reserve(points.size());
         for (const auto& [px, py] : points) {
@@ -41,7 +114,7 @@ struct PolylineSoA {
         
     // **maybe add encapsulation to reduce public api surface?
     // **would also make it easier to validate x and y are same size
-    void push_back(double px, double py) {
+    void push_back(T px, T py) {
         x.push_back(px);
         y.push_back(py);
     }
@@ -52,7 +125,7 @@ struct PolylineSoA {
     }
         
     struct PointView {
-        double x, y;
+        T x, y;
     };
         
     PointView operator[](size_t i) const {
@@ -61,6 +134,10 @@ struct PolylineSoA {
     }
 };
 
+using PolylineSoA = BasicPolylineSoA<double>;
+using PolylineSoAf = BasicPolylineSoA<float>;
+using PolylineSoAi = BasicPolylineSoA<int32_t>;
+
 // A polyline represented as a sequence of points
 using Polyline = std::vector<Point>; // maybe keep for now until other implementation are finised
 
@@ -70,7 +147,38 @@ enum class SimplifyAlgorithm {
     SCALAR,    // Baseline scalar implementation
     AVX2,      // AVX2 SIMD implementation
     AVX512,    // AVX-512 SIMD implementation
-    NEON       // ARM NEON SIMD implementation
+    NEON,      // ARM NEON SIMD implementation
+    SSE2       // SSE2 SIMD implementation (x86-64 baseline, for hosts without AVX)
+};
+
+/// How the Douglas-Peucker splits are scheduled
+enum class SimplifyExecution {
+    SERIAL,        // One thread, explicit work stack
+    PARALLEL,      // Fork both halves of large splits as tasks on a thread pool
+    BREADTH_FIRST, // One thread, all segments of a split level scanned in one sweep
+    AUTO           // PARALLEL from DispatchProfile::parallel_min_points points, else SERIAL
+};
+
+/**
+ * Extended options for simplify() and simplify_into().
+ */
+struct SimplifyOptions {
+    SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO;
+    SimplifyExecution execution = SimplifyExecution::SERIAL;
+
+    // PARALLEL only: threads to use (0 = one per hardware thread)
+    size_t num_threads = 0;
+
+    // PARALLEL only: ranges with fewer points than this are finished serially
+    // by whichever thread picked them up. Lower = more, smaller tasks.
+    size_t parallel_threshold = 65536;
+
+    // Drop points within tolerance of the previously kept point before
+    // Douglas-Peucker runs (radial-distance pre-pass). Much faster on dense
+    // traces with runs of near-duplicate points, but the result is no longer
+    // exactly plain Douglas-Peucker: a dropped point can end up as far as
+    // 2 * tolerance from the simplified line.
+    bool radial_prefilter = false;
 };
 
 /**
@@ -91,15 +199,333 @@ PolylineSoA simplify(const PolylineSoA& input,
                   double tolerance,
                   SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO);
 
+/**
+ * Simplify with extended options, e.g. SimplifyExecution::PARALLEL for
+ * single lines with millions of points. Every execution mode produces
+ * exactly the same result as the serial one.
+ */
+PolylineSoA simplify(const PolylineSoA& input,
+                     double tolerance,
+                     const SimplifyOptions& options);
+
+/**
+ * Reusable working memory for simplify_into().
+ *
+ * Holds the keep bitset, the Douglas-Peucker work stack, the breadth-first
+ * levels and the radial pre-pass output. All only ever grow, so once a
+ * scratch has seen the largest input in a workload, further calls don't
+ * touch the heap. Not thread-safe: use one scratch per thread.
+ */
+struct SimplifyScratch {
+    /// A pending [start, end] range on the work stack
+    struct Range {
+        size_t start;
+        size_t end;
+    };
+
+    /// Farthest interior point of a range
+    struct Farthest {
+        double dist_sq;  // Squared perpendicular distance (0 if nothing is off the chord)
+        size_t index;    // Index of the farthest interior point (start if none)
+    };
+
+    std::vector<uint64_t> keep;  // bit i set = input point i survives
+    std::vector<Range> stack;    // pending ranges, see internal::douglas_peucker
+    PolylineSoA prefiltered;     // SimplifyOptions::radial_prefilter survivors
+
+    // SimplifyExecution::BREADTH_FIRST, see internal::simplify_breadth_first
+    std::vector<Range> blocks;         // ranges too long to finish level by level
+    std::vector<Range> level;          // ranges scanned by the current sweep
+    std::vector<Range> next_level;     // their children, in point order
+    std::vector<Farthest> farthest;    // sweep result per range in level
+    std::vector<double> lane_key;      // packed sweep lanes, see internal::PackedLanes
+    std::vector<int64_t> lane_point;
+    std::vector<int64_t> lane_slot;
+    std::vector<size_t> slot_last;
+    std::vector<size_t> slot_segment;
+};
+
+/**
+ * Simplify a polyline into caller-owned storage.
+ *
+ * @param input Input polyline to simplify
+ * @param tolerance Maximum distance a point can be from the simplified line
+ * @param output Receives the simplified polyline (previous contents are discarded)
+ * @param scratch Working memory, reused across calls
+ * @param algorithm Which implementation to use (default: AUTO)
+ *
+ * Same result as simplify(), but with a warmed-up output and scratch the
+ * call does no heap allocation. output must not alias input.
+ */
+void simplify_into(const PolylineSoA& input,
+                   double tolerance,
+                   PolylineSoA& output,
+                   SimplifyScratch& scratch,
+                   SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO);
+
+/**
+ * simplify_into() with extended options.
+ */
+void simplify_into(const PolylineSoA& input,
+                   double tolerance,
+                   PolylineSoA& output,
+                   SimplifyScratch& scratch,
+                   const SimplifyOptions& options);
+
+/**
+ * Douglas-Peucker on single-precision coordinates.
+ *
+ * Distances are computed in float, 8 lanes per AVX2 vector and 16 per
+ * AVX-512 vector; every algorithm still keeps the same points. Serial
+ * execution only. Lines are limited to 2^31 - 1 points.
+ *
+ * @throws std::invalid_argument if tolerance <= 0 or the line is too long
+ */
+PolylineSoAf simplify(const PolylineSoAf& input,
+                      double tolerance,
+                      SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO);
+
+/**
+ * Single-precision simplify() into caller-owned storage, see the double
+ * overload. output must not alias input.
+ */
+void simplify_into(const PolylineSoAf& input,
+                   double tolerance,
+                   PolylineSoAf& output,
+                   SimplifyScratch& scratch,
+                   SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO);
+
+/**
+ * Douglas-Peucker on fixed-point coordinates.
+ *
+ * Distances are ranked by exact 64-bit cross products (8 lanes per AVX-512
+ * vector, 4 per AVX2), so the choice of split point involves no rounding and
+ * no epsilon: a chord is degenerate only if its endpoints are equal. Only
+ * the final comparison against the tolerance is done in double.
+ * Serial execution only.
+ *
+ * Coordinates must lie in [-2^30, 2^30) so that differences fit in 32 bits
+ * and cross products in 64; results are undefined outside that range.
+ *
+ * @throws std::invalid_argument if tolerance <= 0
+ */
+PolylineSoAi simplify(const PolylineSoAi& input,
+                      double tolerance,
+                      SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO);
+
+/**
+ * Fixed-point simplify() into caller-owned storage. output must not alias
+ * input.
+ */
+void simplify_into(const PolylineSoAi& input,
+                   double tolerance,
+                   PolylineSoAi& output,
+                   SimplifyScratch& scratch,
+                   SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO);
+
+/**
+ * Run Douglas-Peucker and return the indices of the surviving vertices,
+ * in increasing order, without copying any coordinates.
+ *
+ * Useful for decimating attribute columns (timestamps, speeds, ...) that sit
+ * alongside the coordinates. Same keep set as simplify() for every algorithm.
+ */
+std::vector<size_t> simplify_indices(const PolylineSoA& input,
+                                     double tolerance,
+                                     SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO);
+
+/**
+ * simplify_indices() into caller-owned storage; no heap allocation once
+ * indices and scratch are warmed up.
+ */
+void simplify_indices_into(const PolylineSoA& input,
+                           double tolerance,
+                           std::vector<size_t>& indices,
+                           SimplifyScratch& scratch,
+                           SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO);
+
+/**
+ * Run Douglas-Peucker and return the keep set as a packed bitmask:
+ * bit (i % 64) of word (i / 64) is set if vertex i survives.
+ */
+std::vector<uint64_t> simplify_mask(const PolylineSoA& input,
+                                    double tolerance,
+                                    SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO);
+
+/**
+ * Compute every vertex's Douglas-Peucker significance in one pass.
+ *
+ * significance[i] is the squared tolerance at which vertex i gets dropped:
+ * simplifying with tolerance t keeps vertex i exactly when
+ * significance[i] > t * t. It's the vertex's squared split distance, clamped
+ * to its parent split's value so it can never outlive the vertex that made
+ * it reachable. Endpoints are +infinity, points never split off are 0.
+ *
+ * Use with simplify_by_significance() to extract any number of tolerances
+ * (e.g. one per zoom level) with a linear filter instead of a full
+ * simplification each.
+ *
+ * @param input Input polyline
+ * @param algorithm Which implementation runs the distance scans
+ * @return One squared significance per input vertex
+ */
+std::vector<double> simplify_significance(const PolylineSoA& input,
+                                          SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO);
+
+/**
+ * Extract the simplification for one tolerance from precomputed significance.
+ * Same result as simplify(input, tolerance) for any algorithm.
+ *
+ * @param input Input polyline
+ * @param significance Output of simplify_significance() for input
+ * @param tolerance Maximum distance a point can be from the simplified line
+ * @param output Receives the simplified polyline (must not alias input)
+ * @param algorithm Which implementation runs the compare-and-compress pass
+ */
+void simplify_by_significance(const PolylineSoA& input,
+                              const std::vector<double>& significance,
+                              double tolerance,
+                              PolylineSoA& output,
+                              SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO);
+
+/**
+ * Simplify a polyline using the Visvalingam-Whyatt algorithm.
+ *
+ * Repeatedly drops the vertex whose triangle with its two current
+ * neighbours has the smallest area, until every remaining vertex's
+ * effective area is at least area_tolerance. An effective area never drops
+ * below that of a vertex removed before it, so larger tolerances keep a
+ * subset of the vertices smaller ones keep. Ties go to the lowest index.
+ *
+ * @param input Input polyline to simplify
+ * @param area_tolerance Minimum triangle area (squared units) a vertex needs to be kept
+ * @param algorithm Which implementation computes the initial areas
+ * @return Simplified polyline
+ *
+ * @throws std::invalid_argument if area_tolerance <= 0
+ */
+PolylineSoA simplify_vw(const PolylineSoA& input,
+                        double area_tolerance,
+                        SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO);
+
+/**
+ * Simplify many polylines in parallel.
+ *
+ * @param inputs Polylines to simplify
+ * @param outputs Receives one simplified polyline per input (outputs[i] for
+ *                inputs[i]); must not alias inputs
+ * @param count Number of polylines
+ * @param tolerance Maximum distance a point can be from the simplified line
+ * @param algorithm Which implementation to use (default: AUTO)
+ * @param num_threads Threads to use, 0 = one per hardware thread; requests
+ *        beyond the hardware's thread count are clamped to it
+ *
+ * Lines are grouped into chunks of roughly equal point count and run on the
+ * process-wide work-stealing pool, so a few huge coastlines don't leave the other threads
+ * idle. Each thread keeps its own SimplifyScratch and results are written
+ * into the existing outputs, so a warmed-up batch does no per-line allocation.
+ */
+void simplify_batch(const PolylineSoA* inputs,
+                    PolylineSoA* outputs,
+                    size_t count,
+                    double tolerance,
+                    SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO,
+                    size_t num_threads = 0);
+
+/**
+ * simplify_batch() over vectors; outputs is resized to inputs.size().
+ */
+void simplify_batch(const std::vector<PolylineSoA>& inputs,
+                    std::vector<PolylineSoA>& outputs,
+                    double tolerance,
+                    SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO,
+                    size_t num_threads = 0);
+
 /**
  * Check which SIMD implementations are available at runtime.
+ *
+ * An ISA is available when this build of the library contains its kernels
+ * and the CPU and OS both support it. The library itself only ever runs
+ * kernels reported here, so one build runs on any CPU of its architecture.
  */
 struct SIMDCapabilities {
     bool avx2_available;
     bool avx512_available;
     bool neon_available;
+    bool sse2_available;
 };
 
 SIMDCapabilities get_simd_capabilities();
 
+/**
+ * Crossover sizes AUTO uses to pick a back end per call.
+ *
+ * A wider ISA only wins once a call has enough work to pay for its setup,
+ * and on some CPUs AVX-512 code also lowers the clock for whatever runs
+ * next to it. AUTO uses an ISA only for calls at least its threshold long
+ * and drops to the next narrower one below that. The defaults keep the
+ * widest ISA for every size and never go parallel.
+ *
+ * calibrate_dispatch() measures the thresholds on the running machine.
+ * They can also be set by hand, e.g. avx512_min_points = SIZE_MAX keeps
+ * AUTO off AVX-512 entirely. If the GEOM_SIMD_DISPATCH_PROFILE environment
+ * variable names a file, the profile is loaded from it on first use; if
+ * that fails, the library calibrates and tries to save the result there.
+ * First use is the first call that reads the profile (an AUTO simplify or
+ * intersection, or get_dispatch_profile()), so that call pays for the
+ * whole calibration, and so does any thread that needs the profile
+ * while it runs. Call get_dispatch_profile() at startup to pay it up front.
+ *
+ * Thresholds only choose which kernels run: every back end gives the same
+ * result.
+ */
+struct DispatchProfile {
+    // Line lengths, in points, from which AUTO simplification uses each ISA
+    size_t avx2_min_points = 0;
+    size_t avx512_min_points = 0;
+    size_t neon_min_points = 0;
+    size_t sse2_min_points = 0;
+
+    // Line length from which SimplifyExecution::AUTO runs PARALLEL
+    size_t parallel_min_points = SIZE_MAX;
+
+    // Edge count from which edge_intersect_range() leaves the scalar loop
+    size_t intersect_simd_min_edges = 0;
+};
+
+/**
+ * Time the back ends on synthetic lines of increasing size and return the
+ * crossovers for this machine. Thresholds for ISAs the CPU lacks keep their
+ * defaults. The result isn't installed, pass it to set_dispatch_profile().
+ *
+ * The single-threaded thresholds take a few tens of milliseconds (about
+ * 35 ms on an AVX-512 server core). On machines with more than one
+ * hardware thread, the parallel threshold adds serial and parallel runs
+ * over lines of up to 2^18 points: about 150 ms more on that core, less
+ * when the parallel runs get more cores.
+ */
+DispatchProfile calibrate_dispatch();
+
+/**
+ * Install the profile AUTO uses from now on. Safe to call while other
+ * threads are simplifying; a call in flight may see the old thresholds.
+ */
+void set_dispatch_profile(const DispatchProfile& profile);
+
+DispatchProfile get_dispatch_profile();
+
+/**
+ * Write a profile as "name value" lines, for load_dispatch_profile() on
+ * later runs. Profiles describe one machine: don't share them between CPUs.
+ * @throws std::runtime_error if the file can't be written
+ */
+void save_dispatch_profile(const DispatchProfile& profile, const std::string& path);
+
+/**
+ * Read a profile written by save_dispatch_profile(). Fields missing from
+ * the file keep their defaults.
+ * @throws std::runtime_error if the file can't be read or a line is malformed
+ */
+DispatchProfile load_dispatch_profile(const std::string& path);
+
 } // namespace geom
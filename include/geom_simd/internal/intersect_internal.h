@@ -0,0 +1,129 @@
+#pragma once
+
+#include "geom_simd/clip.h"
+#include <cstdint>
+#include <vector>
+
+namespace geom {
+namespace intersect {
+namespace internal {
+
+/**
+ * Build the result for a fixed-point hit from its exact numerators and
+ * (positive) denominator. Shared by every *_i32 kernel and compiled without
+ * ISA flags, so t, u and the point round the same way whichever kernel
+ * found the hit.
+ */
+EdgeIntersection fixed_point_hit(const PointI& a1, const PointI& a2,
+                                 int64_t numerator_t, int64_t numerator_u,
+                                 int64_t denominator);
+
+/**
+ * Range kernels behind edge_intersect_range(), one per ISA and element type.
+ * Each tests edges [start_idx, start_idx+count) and writes count results,
+ * reading no vertex past b_vertices[start_idx+count].
+ */
+using EdgeRangeFn = void (*)(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                             size_t start_idx, size_t count, EdgeIntersection* results);
+using EdgeRangeF32Fn = void (*)(const Point& a1, const Point& a2, const PolylineSoAf& b_vertices,
+                                size_t start_idx, size_t count, EdgeIntersection* results);
+using EdgeRangeI32Fn = void (*)(const PointI& a1, const PointI& a2, const PolylineSoAi& b_vertices,
+                                size_t start_idx, size_t count, EdgeIntersection* results);
+
+/**
+ * Batch kernels behind edge_intersect_batch(). Each writes the hits among
+ * edges [start_idx, start_idx+count) to the front of the five columns and
+ * returns how many; the columns need kBatchSlack elements past that.
+ */
+using EdgeBatchFn = size_t (*)(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                               size_t start_idx, size_t count, double* t, double* u,
+                               double* x, double* y, size_t* edge);
+
+/// Widest compress_store
+constexpr size_t kBatchSlack = 8;
+
+/**
+ * Tile kernels behind the polyline find_all_intersections(). Each tests
+ * edges [a_first, a_first+a_count) of a against edges [b_first,
+ * b_first+b_count) of b, reading no vertex past a[a_first+a_count] or
+ * b[b_first+b_count]. Returns how many hits there are and writes the first
+ * `capacity` of them to hits, in no particular order; the caller reruns
+ * the tile with a bigger buffer if that's short. Like EdgeBatchFn, the
+ * kernels never touch a std::vector: a std template instantiated in an ISA
+ * translation unit is a weak symbol the linker may pick for every caller.
+ */
+using EdgeTileFn = size_t (*)(const PolylineSoA& a, size_t a_first, size_t a_count,
+                              const PolylineSoA& b, size_t b_first, size_t b_count,
+                              EdgeHit* hits, size_t capacity);
+
+void edge_range_scalar(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                       size_t start_idx, size_t count, EdgeIntersection* results);
+void edge_range_scalar_f32(const Point& a1, const Point& a2, const PolylineSoAf& b_vertices,
+                           size_t start_idx, size_t count, EdgeIntersection* results);
+void edge_range_scalar_i32(const PointI& a1, const PointI& a2, const PolylineSoAi& b_vertices,
+                           size_t start_idx, size_t count, EdgeIntersection* results);
+size_t edge_batch_scalar(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                         size_t start_idx, size_t count, double* t, double* u,
+                         double* x, double* y, size_t* edge);
+size_t edge_tile_scalar(const PolylineSoA& a, size_t a_first, size_t a_count,
+                        const PolylineSoA& b, size_t b_first, size_t b_count,
+                        EdgeHit* hits, size_t capacity);
+
+#ifdef HAVE_SSE2
+void edge_range_sse2(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                     size_t start_idx, size_t count, EdgeIntersection* results);
+size_t edge_batch_sse2(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                       size_t start_idx, size_t count, double* t, double* u,
+                       double* x, double* y, size_t* edge);
+size_t edge_tile_sse2(const PolylineSoA& a, size_t a_first, size_t a_count,
+                      const PolylineSoA& b, size_t b_first, size_t b_count,
+                      EdgeHit* hits, size_t capacity);
+#endif
+
+#ifdef HAVE_AVX2
+void edge_range_avx2(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                     size_t start_idx, size_t count, EdgeIntersection* results);
+size_t edge_batch_avx2(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                       size_t start_idx, size_t count, double* t, double* u,
+                       double* x, double* y, size_t* edge);
+size_t edge_tile_avx2(const PolylineSoA& a, size_t a_first, size_t a_count,
+                      const PolylineSoA& b, size_t b_first, size_t b_count,
+                      EdgeHit* hits, size_t capacity);
+void edge_range_avx2_f32(const Point& a1, const Point& a2, const PolylineSoAf& b_vertices,
+                         size_t start_idx, size_t count, EdgeIntersection* results);
+void edge_range_avx2_i32(const PointI& a1, const PointI& a2, const PolylineSoAi& b_vertices,
+                         size_t start_idx, size_t count, EdgeIntersection* results);
+#endif
+
+#ifdef HAVE_AVX512
+void edge_range_avx512(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                       size_t start_idx, size_t count, EdgeIntersection* results);
+size_t edge_batch_avx512(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                         size_t start_idx, size_t count, double* t, double* u,
+                         double* x, double* y, size_t* edge);
+size_t edge_tile_avx512(const PolylineSoA& a, size_t a_first, size_t a_count,
+                        const PolylineSoA& b, size_t b_first, size_t b_count,
+                        EdgeHit* hits, size_t capacity);
+void edge_range_avx512_f32(const Point& a1, const Point& a2, const PolylineSoAf& b_vertices,
+                           size_t start_idx, size_t count, EdgeIntersection* results);
+void edge_range_avx512_i32(const PointI& a1, const PointI& a2, const PolylineSoAi& b_vertices,
+                           size_t start_idx, size_t count, EdgeIntersection* results);
+#endif
+
+/**
+ * Intersection kernels for one ISA, analogous to SimplifyBackend.
+ */
+struct IntersectBackend {
+    EdgeRangeFn range;
+    EdgeRangeF32Fn range_f32;
+    EdgeRangeI32Fn range_i32;
+    EdgeBatchFn batch;
+    EdgeTileFn tile;
+};
+
+/// Fastest back end this CPU can run, resolved on first use
+const IntersectBackend& intersect_backend();
+
+} // namespace internal
+} // namespace intersect
+} // namespace geom
@@ -0,0 +1,355 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(__SSE2__) || defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace geom {
+namespace internal {
+namespace simd {
+
+/**
+ * Vec<T, W>: W lanes of T, and the handful of operations the kernels need.
+ *
+ * A kernel is written once as a template over W against these and then
+ * instantiated in each ISA's translation unit: W = 8 is AVX-512, 4 is AVX2
+ * (with FMA), 2 is SSE2 and 1 is plain scalar code that compiles anywhere.
+ * A width is only defined when the translation unit is compiled for its
+ * ISA.
+ *
+ * Each specialization provides:
+ *   reg, mask            Register and lane-mask types
+ *   width                Lanes per register
+ *   zero, set1, iota     Constants; iota() is {0, 1, ..., W - 1}
+ *   load, loadu          Aligned / unaligned full-width load
+ *   maskz_loadu          Load only the lanes in a mask, zero the rest
+ *   storeu               Unaligned full-width store
+ *   add, sub, mul, div
+ *   fmadd, fmsub         a * b +- c, fused where the ISA has FMA
+ *   abs
+ *   xorsign(a, b)        a with its sign flipped where b is negative (exact)
+ *   cmp_gt/ge/le/eq      Ordered compares, to a lane mask
+ *   first_lanes(n)       Mask of lanes [0, n), all of them for n >= W
+ *   all, mask_and, mask_andnot, bits
+ *   select(m, a, b)      b in lanes of m, a elsewhere
+ *   reduce_max/min       Horizontal max / min of all lanes
+ *   compress_store       Pack the lanes set in a bitmask to the front of
+ *                        out; may store a full register, so out needs room
+ *                        for W elements
+ *
+ * Everything here has internal linkage. The same inline function compiled
+ * with different -m flags in two translation units would otherwise be
+ * merged by the linker, and the scalar build could end up running an
+ * AVX-512 copy.
+ *
+ * The same goes for templates from outside this header: a kernel that grows
+ * a std::vector instantiates its reallocation as a weak symbol. Kernels
+ * therefore work on raw pointers into buffers sized by non-ISA code, and a
+ * post-build step (src/check_isa_symbols.cmake) rejects any weak definition
+ * in the kernel objects.
+ */
+namespace {
+
+template <typename T, size_t W>
+struct Vec;
+
+template <>
+struct Vec<double, 1> {
+    using reg = double;
+    using mask = bool;
+    static constexpr size_t width = 1;
+
+    static reg zero() { return 0.0; }
+    static reg set1(double v) { return v; }
+    static reg iota() { return 0.0; }
+
+    static reg load(const double* p) { return *p; }
+    static reg loadu(const double* p) { return *p; }
+    static reg maskz_loadu(mask m, const double* p) { return m ? *p : 0.0; }
+    static void storeu(double* p, reg v) { *p = v; }
+
+    static reg add(reg a, reg b) { return a + b; }
+    static reg sub(reg a, reg b) { return a - b; }
+    static reg mul(reg a, reg b) { return a * b; }
+    static reg div(reg a, reg b) { return a / b; }
+    static reg fmadd(reg a, reg b, reg c) { return a * b + c; }
+    static reg fmsub(reg a, reg b, reg c) { return a * b - c; }
+    static reg abs(reg a) { return a < 0.0 ? -a : a; }
+    static reg xorsign(reg a, reg b) { return std::signbit(b) ? -a : a; }
+
+    static mask cmp_gt(reg a, reg b) { return a > b; }
+    static mask cmp_ge(reg a, reg b) { return a >= b; }
+    static mask cmp_le(reg a, reg b) { return a <= b; }
+    static mask cmp_eq(reg a, reg b) { return a == b; }
+
+    static mask first_lanes(size_t n) { return n > 0; }
+    static mask all() { return true; }
+    static mask mask_and(mask a, mask b) { return a && b; }
+    static mask mask_andnot(mask a, mask b) { return !a && b; }
+    static unsigned bits(mask m) { return m ? 1u : 0u; }
+
+    static reg select(mask m, reg a, reg b) { return m ? b : a; }
+    static double reduce_max(reg a) { return a; }
+    static double reduce_min(reg a) { return a; }
+
+    static void compress_store(double* out, unsigned keep, reg v) { *out = v; (void)keep; }
+};
+
+#ifdef __SSE2__
+
+// SSE2 only, no SSE4.1: blends are and/andnot/or, and there's no FMA, so
+// fmadd / fmsub round twice
+template <>
+struct Vec<double, 2> {
+    using reg = __m128d;
+    using mask = __m128d;  // All-ones lanes
+    static constexpr size_t width = 2;
+
+    static reg zero() { return _mm_setzero_pd(); }
+    static reg set1(double v) { return _mm_set1_pd(v); }
+    static reg iota() { return _mm_setr_pd(0.0, 1.0); }
+
+    static reg load(const double* p) { return _mm_load_pd(p); }
+    static reg loadu(const double* p) { return _mm_loadu_pd(p); }
+    static reg maskz_loadu(mask m, const double* p) {
+        // No masked loads before AVX; never touch a lane outside the mask
+        switch (bits(m)) {
+            case 3: return _mm_loadu_pd(p);
+            case 1: return _mm_load_sd(p);
+            case 2: return _mm_loadh_pd(_mm_setzero_pd(), p + 1);
+            default: return _mm_setzero_pd();
+        }
+    }
+    static void storeu(double* p, reg v) { _mm_storeu_pd(p, v); }
+
+    static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+    static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+    static reg div(reg a, reg b) { return _mm_div_pd(a, b); }
+    static reg fmadd(reg a, reg b, reg c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+    static reg fmsub(reg a, reg b, reg c) { return _mm_sub_pd(_mm_mul_pd(a, b), c); }
+    static reg abs(reg a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static reg xorsign(reg a, reg b) { return _mm_xor_pd(a, _mm_and_pd(b, _mm_set1_pd(-0.0))); }
+
+    static mask cmp_gt(reg a, reg b) { return _mm_cmpgt_pd(a, b); }
+    static mask cmp_ge(reg a, reg b) { return _mm_cmpge_pd(a, b); }
+    static mask cmp_le(reg a, reg b) { return _mm_cmple_pd(a, b); }
+    static mask cmp_eq(reg a, reg b) { return _mm_cmpeq_pd(a, b); }
+
+    static mask first_lanes(size_t n) {
+        return _mm_castsi128_pd(_mm_set_epi64x(n > 1 ? -1 : 0, n > 0 ? -1 : 0));
+    }
+    static mask all() { return _mm_castsi128_pd(_mm_set1_epi32(-1)); }
+    static mask mask_and(mask a, mask b) { return _mm_and_pd(a, b); }
+    static mask mask_andnot(mask a, mask b) { return _mm_andnot_pd(a, b); }
+    static unsigned bits(mask m) { return static_cast<unsigned>(_mm_movemask_pd(m)); }
+
+    static reg select(mask m, reg a, reg b) {
+        return _mm_or_pd(_mm_and_pd(m, b), _mm_andnot_pd(m, a));
+    }
+
+    static double reduce_max(reg a) {
+        return _mm_cvtsd_f64(_mm_max_pd(a, _mm_unpackhi_pd(a, a)));
+    }
+    static double reduce_min(reg a) {
+        return _mm_cvtsd_f64(_mm_min_pd(a, _mm_unpackhi_pd(a, a)));
+    }
+
+    static void compress_store(double* out, unsigned keep, reg v) {
+        _mm_storeu_pd(out, keep == 2 ? _mm_unpackhi_pd(v, v) : v);
+    }
+};
+
+#endif // __SSE2__
+
+#if defined(__AVX2__) && defined(__FMA__)
+
+// _mm256_permutevar8x32_ps indices that pack the selected double lanes of a
+// 4-bit mask to the front, i.e. a software vcompresspd
+alignas(32) const int32_t kCompressLut4[16][8] = {
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 1, 0, 0, 0, 0, 0, 0},
+    {2, 3, 0, 0, 0, 0, 0, 0},
+    {0, 1, 2, 3, 0, 0, 0, 0},
+    {4, 5, 0, 0, 0, 0, 0, 0},
+    {0, 1, 4, 5, 0, 0, 0, 0},
+    {2, 3, 4, 5, 0, 0, 0, 0},
+    {0, 1, 2, 3, 4, 5, 0, 0},
+    {6, 7, 0, 0, 0, 0, 0, 0},
+    {0, 1, 6, 7, 0, 0, 0, 0},
+    {2, 3, 6, 7, 0, 0, 0, 0},
+    {0, 1, 2, 3, 6, 7, 0, 0},
+    {4, 5, 6, 7, 0, 0, 0, 0},
+    {0, 1, 4, 5, 6, 7, 0, 0},
+    {2, 3, 4, 5, 6, 7, 0, 0},
+    {0, 1, 2, 3, 4, 5, 6, 7},
+};
+
+template <>
+struct Vec<double, 4> {
+    using reg = __m256d;
+    using mask = __m256d;  // All-ones lanes
+    static constexpr size_t width = 4;
+
+    static reg zero() { return _mm256_setzero_pd(); }
+    static reg set1(double v) { return _mm256_set1_pd(v); }
+    static reg iota() { return _mm256_setr_pd(0.0, 1.0, 2.0, 3.0); }
+
+    static reg load(const double* p) { return _mm256_load_pd(p); }
+    static reg loadu(const double* p) { return _mm256_loadu_pd(p); }
+    static reg maskz_loadu(mask m, const double* p) {
+        return _mm256_maskload_pd(p, _mm256_castpd_si256(m));
+    }
+    static void storeu(double* p, reg v) { _mm256_storeu_pd(p, v); }
+
+    static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+    static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+    static reg div(reg a, reg b) { return _mm256_div_pd(a, b); }
+    static reg fmadd(reg a, reg b, reg c) { return _mm256_fmadd_pd(a, b, c); }
+    static reg fmsub(reg a, reg b, reg c) { return _mm256_fmsub_pd(a, b, c); }
+    static reg abs(reg a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static reg xorsign(reg a, reg b) {
+        return _mm256_xor_pd(a, _mm256_and_pd(b, _mm256_set1_pd(-0.0)));
+    }
+
+    static mask cmp_gt(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static mask cmp_ge(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+    static mask cmp_le(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    static mask cmp_eq(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+
+    static mask first_lanes(size_t n) {
+        __m256i lanes = _mm256_setr_epi64x(0, 1, 2, 3);
+        __m256i limit = _mm256_set1_epi64x(static_cast<long long>(n < width ? n : width));
+        return _mm256_castsi256_pd(_mm256_cmpgt_epi64(limit, lanes));
+    }
+    static mask all() { return _mm256_castsi256_pd(_mm256_set1_epi64x(-1)); }
+    static mask mask_and(mask a, mask b) { return _mm256_and_pd(a, b); }
+    static mask mask_andnot(mask a, mask b) { return _mm256_andnot_pd(a, b); }
+    static unsigned bits(mask m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+
+    static reg select(mask m, reg a, reg b) { return _mm256_blendv_pd(a, b, m); }
+
+    static double reduce_max(reg a) {
+        __m256d m = _mm256_max_pd(a, _mm256_permute2f128_pd(a, a, 0x01));
+        m = _mm256_max_pd(m, _mm256_permute_pd(m, 0x5));
+        return _mm256_cvtsd_f64(m);
+    }
+    static double reduce_min(reg a) {
+        __m256d m = _mm256_min_pd(a, _mm256_permute2f128_pd(a, a, 0x01));
+        m = _mm256_min_pd(m, _mm256_permute_pd(m, 0x5));
+        return _mm256_cvtsd_f64(m);
+    }
+
+    static void compress_store(double* out, unsigned keep, reg v) {
+        __m256i perm = _mm256_load_si256(reinterpret_cast<const __m256i*>(kCompressLut4[keep]));
+        _mm256_storeu_pd(out, _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(v), perm)));
+    }
+};
+
+#endif // __AVX2__ && __FMA__
+
+#ifdef __AVX512F__
+
+template <>
+struct Vec<double, 8> {
+    using reg = __m512d;
+    using mask = __mmask8;
+    static constexpr size_t width = 8;
+
+    static reg zero() { return _mm512_setzero_pd(); }
+    static reg set1(double v) { return _mm512_set1_pd(v); }
+    static reg iota() { return _mm512_setr_pd(0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0); }
+
+    static reg load(const double* p) { return _mm512_load_pd(p); }
+    static reg loadu(const double* p) { return _mm512_loadu_pd(p); }
+    static reg maskz_loadu(mask m, const double* p) { return _mm512_maskz_loadu_pd(m, p); }
+    static void storeu(double* p, reg v) { _mm512_storeu_pd(p, v); }
+
+    static reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+    static reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+    static reg div(reg a, reg b) { return _mm512_div_pd(a, b); }
+    static reg fmadd(reg a, reg b, reg c) { return _mm512_fmadd_pd(a, b, c); }
+    static reg fmsub(reg a, reg b, reg c) { return _mm512_fmsub_pd(a, b, c); }
+    static reg abs(reg a) { return _mm512_abs_pd(a); }
+    static reg xorsign(reg a, reg b) {
+        // Floating-point xor/and are AVX512DQ, so go through the integer ops
+        __m512i sign = _mm512_and_si512(_mm512_castpd_si512(b), _mm512_set1_epi64(INT64_MIN));
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), sign));
+    }
+
+    static mask cmp_gt(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+    static mask cmp_ge(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+    static mask cmp_le(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+    static mask cmp_eq(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+
+    static mask first_lanes(size_t n) {
+        return n >= width ? mask(0xFF) : static_cast<mask>((1u << n) - 1);
+    }
+    static mask all() { return 0xFF; }
+    static mask mask_and(mask a, mask b) { return a & b; }
+    static mask mask_andnot(mask a, mask b) { return static_cast<mask>(~a & b); }
+    static unsigned bits(mask m) { return m; }
+
+    static reg select(mask m, reg a, reg b) { return _mm512_mask_mov_pd(a, m, b); }
+
+    // Shuffle trees by hand with zero-masked ops: GCC 12 flags the undefined
+    // passthrough inside _mm512_reduce_* as maybe-uninitialized
+    static double reduce_max(reg a) {
+        __m512d m = _mm512_maskz_max_pd(0xFF, a, _mm512_maskz_shuffle_f64x2(0xFF, a, a, _MM_SHUFFLE(1, 0, 3, 2)));
+        m = _mm512_maskz_max_pd(0xFF, m, _mm512_maskz_shuffle_f64x2(0xFF, m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+        m = _mm512_maskz_max_pd(0xFF, m, _mm512_maskz_permute_pd(0xFF, m, 0x55));
+        return _mm512_cvtsd_f64(m);
+    }
+    static double reduce_min(reg a) {
+        __m512d m = _mm512_maskz_min_pd(0xFF, a, _mm512_maskz_shuffle_f64x2(0xFF, a, a, _MM_SHUFFLE(1, 0, 3, 2)));
+        m = _mm512_maskz_min_pd(0xFF, m, _mm512_maskz_shuffle_f64x2(0xFF, m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+        m = _mm512_maskz_min_pd(0xFF, m, _mm512_maskz_permute_pd(0xFF, m, 0x55));
+        return _mm512_cvtsd_f64(m);
+    }
+
+    static void compress_store(double* out, unsigned keep, reg v) {
+        _mm512_mask_compressstoreu_pd(out, static_cast<mask>(keep), v);
+    }
+};
+
+#endif // __AVX512F__
+
+/**
+ * Fold per-lane running maxima and their indices (carried as doubles, exact
+ * up to 2^53) into max_key / max_idx. Ties go to the lowest index, so every
+ * width picks the same point as a scalar scan.
+ *
+ * No store and no per-lane branches: on short segments the reduction is most
+ * of the work, and a branchy scan mispredicts on nearly every one.
+ */
+template <size_t W>
+inline void reduce_argmax(typename Vec<double, W>::reg vmax, typename Vec<double, W>::reg vidx,
+                          double& max_key, size_t& max_idx) {
+    using V = Vec<double, W>;
+    double lane_max = V::reduce_max(vmax);
+    if (lane_max < max_key) {
+        return;
+    }
+
+    // Lowest index among the lanes holding the max
+    typename V::mask at_max = V::cmp_eq(vmax, V::set1(lane_max));
+    double none = std::numeric_limits<double>::infinity();
+    size_t idx = static_cast<size_t>(V::reduce_min(V::select(at_max, V::set1(none), vidx)));
+    if (lane_max > max_key || idx < max_idx) {
+        max_key = lane_max;
+        max_idx = idx;
+    }
+}
+
+} // anonymous namespace
+
+} // namespace simd
+} // namespace internal
+} // namespace geom
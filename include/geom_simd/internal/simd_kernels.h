@@ -0,0 +1,704 @@
+#pragma once
+
+#include "geom_simd/clip.h"
+#include "geom_simd/internal/simd.h"
+#include "geom_simd/internal/simplify_internal.h"
+#include <algorithm>
+#include <limits>
+
+/**
+ * Kernels written once against simd::Vec and instantiated per ISA, each in
+ * the translation unit compiled for that ISA (e.g. find_farthest_avx2() is
+ * find_farthest_simd<4>). Internal linkage for the same reason as simd.h.
+ */
+
+namespace geom {
+namespace internal {
+
+namespace {
+
+// Segments with fewer interior points than this skip the vector setup in
+// find_farthest_simd() (measured with BM_ShortSegments). SSE2 has no blend,
+// so its selects cost three ops each and the crossover sits much higher.
+template <size_t W>
+constexpr size_t kScalarMaxInterior = W == 2 ? 16 : 4;
+
+/**
+ * Max-distance scan, W points per iteration. Keys are cross^2 (or point
+ * distance^2 for a degenerate chord) from mul/sub, not fused, so every
+ * width computes the same keys; the division by |chord|^2 waits until
+ * after the argmax. Ties go to the lowest index.
+ *
+ * Interior points are walked in aligned blocks of W over the 64-byte
+ * aligned, padded storage. Lanes below start + 1 in the first block and
+ * from end in the last are masked out of the compare rather than the load,
+ * so there's no scalar head or tail.
+ */
+template <size_t W>
+FarthestPoint find_farthest_simd(const PolylineSoA& points, size_t start, size_t end) {
+    using V = simd::Vec<double, W>;
+    using reg = typename V::reg;
+    using mask = typename V::mask;
+
+    size_t first = start + 1;
+    if (first >= end) {
+        return {0.0, start};
+    }
+
+    const double* xs = points.x.data();
+    const double* ys = points.y.data();
+    double px1 = xs[start];
+    double py1 = ys[start];
+    double seg_dx = xs[end] - px1;
+    double seg_dy = ys[end] - py1;
+    double seg_mag_sq = seg_dx * seg_dx + seg_dy * seg_dy;
+
+    // Same degenerate-chord rule as perpendicular_distance(): closed rings
+    // have start == end, so rank by distance to that point instead
+    const bool degenerate = seg_mag_sq < 1e-10;
+
+    // A few points are cheaper as a plain loop than as one masked block plus
+    // the horizontal reduction, and the DP driver waits on every result
+    if (end - first < kScalarMaxInterior<W>) {
+        double max_key = 0.0;
+        size_t max_idx = start;
+        for (size_t k = first; k < end; ++k) {
+            double dpx = xs[k] - px1;
+            double dpy = ys[k] - py1;
+            double cross = dpx * seg_dy - dpy * seg_dx;
+            double key = degenerate ? dpx * dpx + dpy * dpy : cross * cross;
+            if (key > max_key) {
+                max_key = key;
+                max_idx = k;
+            }
+        }
+        return {degenerate ? max_key : max_key / seg_mag_sq, max_idx};
+    }
+
+    reg x1 = V::set1(px1);
+    reg y1 = V::set1(py1);
+    reg dx = V::set1(seg_dx);
+    reg dy = V::set1(seg_dy);
+
+    auto distance_key = [&](reg px, reg py) {
+        reg dpx = V::sub(px, x1);
+        reg dpy = V::sub(py, y1);
+        if (degenerate) {
+            return V::add(V::mul(dpx, dpx), V::mul(dpy, dpy));
+        }
+        reg cross = V::sub(V::mul(dpx, dy), V::mul(dpy, dx));
+        return V::mul(cross, cross);
+    };
+
+    // Running max and its index stay in registers for the whole scan
+    reg vmax = V::zero();
+    reg vidx = V::set1(static_cast<double>(start));
+    reg cur_idx;
+    const reg step_idx = V::set1(static_cast<double>(W));
+
+    // Strict gt keeps the first hit per lane, same as the scalar scan
+    auto step = [&](reg key) {
+        mask gt = V::cmp_gt(key, vmax);
+        vmax = V::select(gt, vmax, key);
+        vidx = V::select(gt, vidx, cur_idx);
+        cur_idx = V::add(cur_idx, step_idx);
+    };
+    auto step_masked = [&](mask lanes, reg key) {
+        mask gt = V::mask_and(V::cmp_gt(key, vmax), lanes);
+        vmax = V::select(gt, vmax, key);
+        vidx = V::select(gt, vidx, cur_idx);
+        cur_idx = V::add(cur_idx, step_idx);
+    };
+
+    if (end - first <= W) {
+        // One unaligned block covers every interior point, however they
+        // straddle the alignment
+        mask lanes = V::first_lanes(end - first);
+        cur_idx = V::add(V::iota(), V::set1(static_cast<double>(first)));
+        step_masked(lanes, distance_key(V::loadu(&xs[first]), V::loadu(&ys[first])));
+    } else {
+        size_t i = first & ~(W - 1);
+        cur_idx = V::add(V::iota(), V::set1(static_cast<double>(i)));
+
+        // Head block; more than W interior points, so it's never the tail
+        mask head = V::mask_andnot(V::first_lanes(first - i), V::all());
+        step_masked(head, distance_key(V::load(&xs[i]), V::load(&ys[i])));
+        i += W;
+
+        // Hot loop, aligned full-width loads
+        for (; i + W <= end; i += W) {
+            step(distance_key(V::load(&xs[i]), V::load(&ys[i])));
+        }
+
+        // Tail block reads into the padding
+        if (i < end) {
+            step_masked(V::first_lanes(end - i), distance_key(V::load(&xs[i]), V::load(&ys[i])));
+        }
+    }
+
+    double max_key = 0.0;
+    size_t max_idx = start;
+    simd::reduce_argmax<W>(vmax, vidx, max_key, max_idx);
+
+    double max_dist_sq = degenerate ? max_key : max_key / seg_mag_sq;
+    return {max_dist_sq, max_idx};
+}
+
+/**
+ * filter_significant() kernel: compare W significances per iteration and
+ * compress the survivors' coordinates to the front of out_x / out_y.
+ */
+template <size_t W>
+size_t filter_significant_simd(const double* x, const double* y, const double* significance,
+                               size_t n, double threshold, double* out_x, double* out_y) {
+    using V = simd::Vec<double, W>;
+
+    typename V::reg vthreshold = V::set1(threshold);
+    size_t count = 0;
+    size_t i = 0;
+
+    // Full-width stores are safe: count <= i, and out_* hold n elements
+    for (; i + W <= n; i += W) {
+        unsigned keep = V::bits(V::cmp_gt(V::loadu(&significance[i]), vthreshold));
+        V::compress_store(&out_x[count], keep, V::loadu(&x[i]));
+        V::compress_store(&out_y[count], keep, V::loadu(&y[i]));
+        count += static_cast<size_t>(__builtin_popcount(keep));
+    }
+
+    // Branch-free tail: always write, only advance on a hit
+    for (; i < n; ++i) {
+        out_x[count] = x[i];
+        out_y[count] = y[i];
+        count += significance[i] > threshold ? 1 : 0;
+    }
+
+    return count;
+}
+
+/**
+ * triangle_areas() kernel. Three overlapping loads per coordinate give the
+ * (i - 1, i, i + 1) triples; mul/sub in triangle_area()'s order, so the
+ * areas match the scalar ones bit for bit.
+ */
+template <size_t W>
+void triangle_areas_simd(const double* x, const double* y, size_t n, double* areas) {
+    using V = simd::Vec<double, W>;
+    using reg = typename V::reg;
+
+    const reg half = V::set1(0.5);
+
+    areas[0] = std::numeric_limits<double>::infinity();
+    size_t i = 1;
+
+    for (; i + W < n; i += W) {
+        reg x0 = V::loadu(&x[i - 1]);
+        reg y0 = V::loadu(&y[i - 1]);
+        reg ax = V::sub(V::loadu(&x[i]), x0);
+        reg ay = V::sub(V::loadu(&y[i]), y0);
+        reg bx = V::sub(V::loadu(&x[i + 1]), x0);
+        reg by = V::sub(V::loadu(&y[i + 1]), y0);
+
+        reg cross = V::sub(V::mul(ax, by), V::mul(ay, bx));
+        V::storeu(&areas[i], V::mul(half, V::abs(cross)));
+    }
+
+    for (; i + 1 < n; ++i) {
+        areas[i] = triangle_area(x[i - 1], y[i - 1], x[i], y[i], x[i + 1], y[i + 1]);
+    }
+    areas[n - 1] = std::numeric_limits<double>::infinity();
+}
+
+/**
+ * find_exit() kernel: W strip tests per iteration, stopping at the first
+ * block with a point outside.
+ */
+template <size_t W>
+size_t find_exit_simd(const double* x, const double* y, size_t n,
+                      double kx, double ky, double dx, double dy, double limit) {
+    using V = simd::Vec<double, W>;
+    using reg = typename V::reg;
+
+    reg vkx = V::set1(kx);
+    reg vky = V::set1(ky);
+    reg vdx = V::set1(dx);
+    reg vdy = V::set1(dy);
+    reg vlimit = V::set1(limit);
+
+    size_t i = 0;
+    for (; i + W <= n; i += W) {
+        reg dpx = V::sub(V::loadu(&x[i]), vkx);
+        reg dpy = V::sub(V::loadu(&y[i]), vky);
+        // mul/sub, not fmsub, so the key matches strip_cross_sq() exactly
+        reg cross = V::sub(V::mul(dpx, vdy), V::mul(dpy, vdx));
+        unsigned outside = V::bits(V::cmp_gt(V::mul(cross, cross), vlimit));
+        if (outside) {
+            return i + static_cast<size_t>(__builtin_ctz(outside));
+        }
+    }
+
+    for (; i < n; ++i) {
+        if (strip_cross_sq(x[i], y[i], kx, ky, dx, dy) > limit) {
+            return i;
+        }
+    }
+    return n;
+}
+
+/**
+ * radial_filter() kernel, W points per iteration. A block with nothing far
+ * from the key is skipped whole; otherwise the run of kept points in it is
+ * found from two masks and compressed out in one go.
+ */
+template <size_t W>
+size_t radial_filter_simd(const double* x, const double* y, size_t n,
+                          double tolerance_sq, double* out_x, double* out_y) {
+    using V = simd::Vec<double, W>;
+    using reg = typename V::reg;
+
+    reg vtolerance = V::set1(tolerance_sq);
+
+    // mul/add, not fmadd, so distances round like radial_filter_scalar()
+    auto far_from = [&](reg px, reg py, reg kx, reg ky) {
+        reg dx = V::sub(px, kx);
+        reg dy = V::sub(py, ky);
+        reg dist_sq = V::add(V::mul(dx, dx), V::mul(dy, dy));
+        return V::bits(V::cmp_gt(dist_sq, vtolerance));
+    };
+
+    out_x[0] = x[0];
+    out_y[0] = y[0];
+    size_t count = 1;
+    size_t key = 0;
+    reg kx = V::set1(x[0]);
+    reg ky = V::set1(y[0]);
+
+    // Full-width stores are safe: count <= i, and out_* hold n elements
+    size_t i = 1;
+    while (i + W <= n) {
+        reg px = V::loadu(&x[i]);
+        reg py = V::loadu(&y[i]);
+
+        unsigned far_key = far_from(px, py, kx, ky);
+        if (!far_key) {
+            i += W;
+            continue;
+        }
+
+        // The first lane clear of the key is kept. Each lane after it is
+        // kept for as long as it's clear of its predecessor, which is then
+        // the key; the first that isn't restarts the scan against a new key.
+        unsigned far_prev = far_from(px, py, V::loadu(&x[i - 1]), V::loadu(&y[i - 1]));
+        unsigned first = static_cast<unsigned>(__builtin_ctz(far_key));
+        unsigned stop = first + 1 + static_cast<unsigned>(__builtin_ctz(~(far_prev >> (first + 1))));
+
+        unsigned kept = ((1u << stop) - 1) & ~((1u << first) - 1);
+        V::compress_store(&out_x[count], kept, px);
+        V::compress_store(&out_y[count], kept, py);
+        count += stop - first;
+
+        key = i + stop - 1;
+        kx = V::set1(x[key]);
+        ky = V::set1(y[key]);
+        i += stop;
+    }
+
+    for (; i < n; ++i) {
+        double dx = x[i] - x[key];
+        double dy = y[i] - y[key];
+        if (dx * dx + dy * dy > tolerance_sq) {
+            out_x[count] = x[i];
+            out_y[count] = y[i];
+            ++count;
+            key = i;
+        }
+    }
+
+    // The last point is always kept, however close it is
+    if (key != n - 1) {
+        out_x[count] = x[n - 1];
+        out_y[count] = y[n - 1];
+        ++count;
+    }
+
+    return count;
+}
+
+/**
+ * Twice the signed area of the polyline's edges (i, i + 1) for i in
+ * [0, count), by the shoelace formula. Reads x[0..count] and y[0..count].
+ */
+template <size_t W>
+double shoelace_simd(const double* x, const double* y, size_t count) {
+    using V = simd::Vec<double, W>;
+    using reg = typename V::reg;
+
+    reg sum = V::zero();
+    size_t i = 0;
+    for (; i + W <= count; i += W) {
+        reg xi = V::loadu(&x[i]);
+        reg yi = V::loadu(&y[i]);
+        sum = V::add(sum, V::sub(V::mul(xi, V::loadu(&y[i + 1])), V::mul(V::loadu(&x[i + 1]), yi)));
+    }
+
+    double lanes[W];
+    V::storeu(lanes, sum);
+    double area = 0.0;
+    for (size_t j = 0; j < W; ++j) {
+        area += lanes[j];
+    }
+
+    for (; i < count; ++i) {
+        area += x[i] * y[i + 1] - x[i + 1] * y[i];
+    }
+    return area;
+}
+
+/**
+ * Even-odd ray casting over the polyline's edges (i, i + 1) for i in
+ * [0, count): true if an odd number of them cross the ray from (px, py)
+ * towards +x. Same crossing test, in the same order, as the scalar loop in
+ * Polygon::contains(). Reads x[0..count] and y[0..count].
+ */
+template <size_t W>
+bool crosses_odd_simd(const double* x, const double* y, size_t count, double px, double py) {
+    using V = simd::Vec<double, W>;
+    using reg = typename V::reg;
+
+    reg vpx = V::set1(px);
+    reg vpy = V::set1(py);
+    unsigned crossings = 0;
+
+    size_t i = 0;
+    for (; i + W <= count; i += W) {
+        reg xi = V::loadu(&x[i]);
+        reg yi = V::loadu(&y[i]);
+        reg xj = V::loadu(&x[i + 1]);
+        reg yj = V::loadu(&y[i + 1]);
+
+        // Edges that straddle the ray's y; the division is only meaningful
+        // (and only looked at) for those, and most blocks have none
+        unsigned straddles = V::bits(V::cmp_gt(yi, vpy)) ^ V::bits(V::cmp_gt(yj, vpy));
+        if (straddles == 0) {
+            continue;
+        }
+        reg x_cross = V::add(V::div(V::mul(V::sub(xj, xi), V::sub(vpy, yi)), V::sub(yj, yi)), xi);
+        crossings ^= static_cast<unsigned>(__builtin_popcount(straddles & V::bits(V::cmp_gt(x_cross, vpx))));
+    }
+
+    bool inside = (crossings & 1) != 0;
+    for (; i < count; ++i) {
+        double xi = x[i], yi = y[i], xj = x[i + 1], yj = y[i + 1];
+        if (((yi > py) != (yj > py)) && (px < (xj - xi) * (py - yi) / (yj - yi) + xi)) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+} // anonymous namespace
+
+} // namespace internal
+
+namespace intersect {
+namespace internal {
+
+namespace {
+
+/**
+ * One block of W edges (b1[j], b2[j]) against edge A, before it is written
+ * out. hits has a bit per lane that intersects and is inside valid; the
+ * other fields are only meaningful in those lanes.
+ */
+template <size_t W>
+struct BlockLanes {
+    typename geom::internal::simd::Vec<double, W>::reg t, u, ix, iy;
+    unsigned hits;
+};
+
+/**
+ * Same parametrization, parallel threshold and division-free range test as
+ * edge_intersect_scalar(), in the same mul/sub order and not fused, so
+ * every width rounds each pair exactly like the scalar kernel: an endpoint
+ * resting on the other edge is a hit on every CPU or on none. t, u and the
+ * point are only computed when some lane hits.
+ *
+ * Takes edge A broadcast and both edges as start point plus delta, so the
+ * tile kernel can keep B's deltas in registers across many A edges.
+ *
+ * Forced inline: GCC doesn't vzeroupper on return from a local function
+ * taking vector arguments, and the dirty upper state slowed the scalar
+ * code after every range call by more than 10x.
+ */
+template <size_t W>
+__attribute__((always_inline)) inline BlockLanes<W> intersect_deltas_simd(
+                          typename geom::internal::simd::Vec<double, W>::reg vax1,
+                          typename geom::internal::simd::Vec<double, W>::reg vay1,
+                          typename geom::internal::simd::Vec<double, W>::reg dx_a,
+                          typename geom::internal::simd::Vec<double, W>::reg dy_a,
+                          typename geom::internal::simd::Vec<double, W>::reg bx1,
+                          typename geom::internal::simd::Vec<double, W>::reg by1,
+                          typename geom::internal::simd::Vec<double, W>::reg dx_b,
+                          typename geom::internal::simd::Vec<double, W>::reg dy_b,
+                          typename geom::internal::simd::Vec<double, W>::mask valid) {
+    using V = geom::internal::simd::Vec<double, W>;
+    using reg = typename V::reg;
+    using mask = typename V::mask;
+
+    // (A2 - A1) x (B2 - B1)
+    reg denominator = V::sub(V::mul(dx_a, dy_b), V::mul(dy_a, dx_b));
+
+    // (B1 - A1) x (B2 - B1) and (B1 - A1) x (A2 - A1)
+    reg dx_ab = V::sub(bx1, vax1);
+    reg dy_ab = V::sub(by1, vay1);
+    reg numerator_t = V::sub(V::mul(dx_ab, dy_b), V::mul(dy_ab, dx_b));
+    reg numerator_u = V::sub(V::mul(dx_ab, dy_a), V::mul(dy_ab, dx_a));
+
+    // t and u are in [0, 1] iff their numerators, signs flipped with the
+    // denominator's, are in [0, |denominator|]
+    reg zero = V::zero();
+    reg magnitude = V::abs(denominator);
+    reg scaled_t = V::xorsign(numerator_t, denominator);
+    reg scaled_u = V::xorsign(numerator_u, denominator);
+    mask hits = V::mask_and(V::cmp_ge(scaled_t, zero), V::cmp_le(scaled_t, magnitude));
+    hits = V::mask_and(hits, V::mask_and(V::cmp_ge(scaled_u, zero), V::cmp_le(scaled_u, magnitude)));
+    hits = V::mask_and(hits, V::cmp_ge(magnitude, V::set1(1e-10)));
+    unsigned bits = V::bits(V::mask_and(hits, valid));
+
+    // Most blocks miss entirely on sparse workloads
+    if (bits == 0) {
+        return {zero, zero, zero, zero, 0};
+    }
+
+    reg t = V::div(numerator_t, denominator);
+    reg u = V::div(numerator_u, denominator);
+    return {t, u, V::add(vax1, V::mul(t, dx_a)), V::add(vay1, V::mul(t, dy_a)), bits};
+}
+
+/**
+ * intersect_deltas_simd() for edge A against edges (b1[j], b2[j]).
+ */
+template <size_t W>
+__attribute__((always_inline)) inline BlockLanes<W> intersect_lanes_simd(const Point& a1, const Point& a2,
+                          typename geom::internal::simd::Vec<double, W>::reg bx1,
+                          typename geom::internal::simd::Vec<double, W>::reg by1,
+                          typename geom::internal::simd::Vec<double, W>::reg bx2,
+                          typename geom::internal::simd::Vec<double, W>::reg by2,
+                          typename geom::internal::simd::Vec<double, W>::mask valid) {
+    using V = geom::internal::simd::Vec<double, W>;
+
+    return intersect_deltas_simd<W>(V::set1(a1.x), V::set1(a1.y),
+                                    V::set1(a2.x - a1.x), V::set1(a2.y - a1.y),
+                                    bx1, by1, V::sub(bx2, bx1), V::sub(by2, by1), valid);
+}
+
+/**
+ * Edges (b1[j], b2[j]) against edge A, W at a time; lanes outside valid
+ * report no intersection.
+ */
+template <size_t W>
+__attribute__((always_inline)) inline void intersect_block_simd(const Point& a1, const Point& a2,
+                          typename geom::internal::simd::Vec<double, W>::reg bx1,
+                          typename geom::internal::simd::Vec<double, W>::reg by1,
+                          typename geom::internal::simd::Vec<double, W>::reg bx2,
+                          typename geom::internal::simd::Vec<double, W>::reg by2,
+                          typename geom::internal::simd::Vec<double, W>::mask valid,
+                          EdgeIntersection* results) {
+    using V = geom::internal::simd::Vec<double, W>;
+
+    BlockLanes<W> lanes = intersect_lanes_simd<W>(a1, a2, bx1, by1, bx2, by2, valid);
+    if (lanes.hits == 0) {
+        std::fill(results, results + W, EdgeIntersection());
+        return;
+    }
+
+    double t_array[W], u_array[W], ix_array[W], iy_array[W];
+    V::storeu(t_array, lanes.t);
+    V::storeu(u_array, lanes.u);
+    V::storeu(ix_array, lanes.ix);
+    V::storeu(iy_array, lanes.iy);
+
+    for (size_t i = 0; i < W; ++i) {
+        if (lanes.hits & (1u << i)) {
+            results[i] = EdgeIntersection(true, t_array[i], u_array[i], ix_array[i], iy_array[i]);
+        } else {
+            results[i] = EdgeIntersection();
+        }
+    }
+}
+
+/**
+ * edge_intersect_range() kernel: full blocks with plain loads straight into
+ * results, then one masked block into a local buffer. Reads no vertex past
+ * xs[count] / ys[count].
+ */
+template <size_t W>
+void edge_range_simd(const Point& a1, const Point& a2, const double* xs, const double* ys,
+                     size_t count, EdgeIntersection* results) {
+    using V = geom::internal::simd::Vec<double, W>;
+
+    size_t i = 0;
+    for (; i + W <= count; i += W) {
+        intersect_block_simd<W>(a1, a2, V::loadu(xs + i), V::loadu(ys + i),
+                                V::loadu(xs + i + 1), V::loadu(ys + i + 1), V::all(), &results[i]);
+    }
+    if (i < count) {
+        typename V::mask valid = V::first_lanes(count - i);
+        EdgeIntersection tail[W];
+        intersect_block_simd<W>(a1, a2, V::maskz_loadu(valid, xs + i), V::maskz_loadu(valid, ys + i),
+                                V::maskz_loadu(valid, xs + i + 1), V::maskz_loadu(valid, ys + i + 1),
+                                valid, tail);
+        std::copy(tail, tail + (count - i), &results[i]);
+    }
+}
+
+/**
+ * edge_intersect_batch() kernel: the blocks of edge_range_simd(), but only
+ * hit lanes are stored, packed to the front of each column with
+ * compress_store, and blocks without a hit store nothing. Edge indices are
+ * first_edge + offset. Returns the number of hits; each column needs W
+ * elements of slack past that, see compress_store.
+ */
+template <size_t W>
+size_t edge_batch_simd(const Point& a1, const Point& a2, const double* xs, const double* ys,
+                       size_t first_edge, size_t count, double* t_out, double* u_out,
+                       double* x_out, double* y_out, size_t* edge_out) {
+    using V = geom::internal::simd::Vec<double, W>;
+
+    size_t n = 0;
+    auto emit = [&](const BlockLanes<W>& lanes, size_t edge) {
+        V::compress_store(t_out + n, lanes.hits, lanes.t);
+        V::compress_store(u_out + n, lanes.hits, lanes.u);
+        V::compress_store(x_out + n, lanes.hits, lanes.ix);
+        V::compress_store(y_out + n, lanes.hits, lanes.iy);
+        for (unsigned m = lanes.hits; m != 0; m &= m - 1) {
+            edge_out[n++] = edge + static_cast<size_t>(__builtin_ctz(m));
+        }
+    };
+
+    size_t i = 0;
+    for (; i + W <= count; i += W) {
+        BlockLanes<W> lanes = intersect_lanes_simd<W>(a1, a2, V::loadu(xs + i), V::loadu(ys + i),
+                                                      V::loadu(xs + i + 1), V::loadu(ys + i + 1),
+                                                      V::all());
+        if (lanes.hits != 0) {
+            emit(lanes, first_edge + i);
+        }
+    }
+    if (i < count) {
+        typename V::mask valid = V::first_lanes(count - i);
+        BlockLanes<W> lanes = intersect_lanes_simd<W>(
+            a1, a2, V::maskz_loadu(valid, xs + i), V::maskz_loadu(valid, ys + i),
+            V::maskz_loadu(valid, xs + i + 1), V::maskz_loadu(valid, ys + i + 1), valid);
+        if (lanes.hits != 0) {
+            emit(lanes, first_edge + i);
+        }
+    }
+    return n;
+}
+
+/**
+ * Hits of edge A (a[i], a[i+1]) among edges [first, first+count) of b, with
+ * count <= W * R, stored from hits[n] on while there's room. Returns n plus
+ * the number of hits, stored or not. Kept out of line so that the hit path
+ * doesn't make edge_tile_simd() spill its tile: every vector register is
+ * call-clobbered, so the tile reloads after a call either way.
+ */
+template <size_t W, size_t R>
+__attribute__((noinline)) size_t emit_tile_hits(const PolylineSoA& a, size_t i,
+                                                const PolylineSoA& b, size_t first, size_t count,
+                                                EdgeHit* hits, size_t capacity, size_t n) {
+    using V = geom::internal::simd::Vec<double, W>;
+
+    Point a1{a.x[i], a.y[i]};
+    Point a2{a.x[i + 1], a.y[i + 1]};
+    const double* xs = &b.x[first];
+    const double* ys = &b.y[first];
+    for (size_t offset = 0; offset < count; offset += W) {
+        typename V::mask valid = V::first_lanes(count - offset);
+        BlockLanes<W> lanes = intersect_lanes_simd<W>(
+            a1, a2, V::maskz_loadu(valid, xs + offset), V::maskz_loadu(valid, ys + offset),
+            V::maskz_loadu(valid, xs + offset + 1), V::maskz_loadu(valid, ys + offset + 1), valid);
+        if (lanes.hits == 0) {
+            continue;
+        }
+
+        double t[W], u[W], ix[W], iy[W];
+        V::storeu(t, lanes.t);
+        V::storeu(u, lanes.u);
+        V::storeu(ix, lanes.ix);
+        V::storeu(iy, lanes.iy);
+        for (unsigned m = lanes.hits; m != 0; m &= m - 1) {
+            unsigned k = static_cast<unsigned>(__builtin_ctz(m));
+            if (n < capacity) {
+                hits[n] = {i, first + offset + k, t[k], u[k], ix[k], iy[k]};
+            }
+            ++n;
+        }
+    }
+    return n;
+}
+
+/**
+ * Tile kernel behind the polyline find_all_intersections(), shaped like a
+ * GEMM micro-kernel: R registers of W edges of B are loaded once and stay
+ * resident while every A edge in [a_first, a_first+a_count) is broadcast
+ * and streamed past them. Compared with one edge_batch_simd() call per A
+ * edge, that saves reloading B and re-deriving its deltas for each A edge.
+ * The loop only tests; an A edge that hits the tile is redone by
+ * emit_tile_hits(), with the same arithmetic. Returns the number of hits
+ * and stores up to capacity of them, in no particular order (EdgeTileFn).
+ *
+ * R * 4 tile registers plus the A broadcasts and temporaries must fit the
+ * register file, or the tile spills and the point is lost.
+ */
+template <size_t W, size_t R>
+size_t edge_tile_simd(const PolylineSoA& a, size_t a_first, size_t a_count,
+                      const PolylineSoA& b, size_t b_first, size_t b_count,
+                      EdgeHit* hits, size_t capacity) {
+    using V = geom::internal::simd::Vec<double, W>;
+    using reg = typename V::reg;
+    using mask = typename V::mask;
+    constexpr size_t kTileEdges = W * R;
+
+    const double* xs = &b.x[b_first];
+    const double* ys = &b.y[b_first];
+    size_t n = 0;
+
+    for (size_t j = 0; j < b_count; j += kTileEdges) {
+        // Masked loads, so a partial tile reads nothing past b[b_first+b_count]
+        reg bx1[R], by1[R], dx_b[R], dy_b[R];
+        mask valid[R];
+        for (size_t r = 0; r < R; ++r) {
+            size_t offset = j + r * W;
+            valid[r] = V::first_lanes(offset < b_count ? b_count - offset : 0);
+            bx1[r] = V::maskz_loadu(valid[r], xs + offset);
+            by1[r] = V::maskz_loadu(valid[r], ys + offset);
+            dx_b[r] = V::sub(V::maskz_loadu(valid[r], xs + offset + 1), bx1[r]);
+            dy_b[r] = V::sub(V::maskz_loadu(valid[r], ys + offset + 1), by1[r]);
+        }
+
+        for (size_t i = a_first; i < a_first + a_count; ++i) {
+            reg vax1 = V::set1(a.x[i]);
+            reg vay1 = V::set1(a.y[i]);
+            reg dx_a = V::set1(a.x[i + 1] - a.x[i]);
+            reg dy_a = V::set1(a.y[i + 1] - a.y[i]);
+            unsigned any = 0;
+            for (size_t r = 0; r < R; ++r) {
+                // Only the mask is used, so the division is dead code here
+                any |= intersect_deltas_simd<W>(vax1, vay1, dx_a, dy_a, bx1[r], by1[r],
+                                                dx_b[r], dy_b[r], valid[r]).hits;
+            }
+            if (any != 0) {
+                n = emit_tile_hits<W, R>(a, i, b, b_first + j, std::min(kTileEdges, b_count - j),
+                                         hits, capacity, n);
+            }
+        }
+    }
+    return n;
+}
+
+} // anonymous namespace
+
+} // namespace internal
+} // namespace intersect
+} // namespace geom
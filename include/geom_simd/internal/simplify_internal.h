@@ -1,30 +1,67 @@
 #pragma once
 
 #include "geom_simd/geom_simd.h"
+#include <cmath>
+#include <vector>
 
 namespace geom {
 namespace internal {
 
+/**
+ * Result of a max-distance scan over the interior of one segment.
+ */
+using FarthestPoint = SimplifyScratch::Farthest;
+
+/**
+ * A pending [start, end] range on the Douglas-Peucker work stack.
+ */
+using Segment = SimplifyScratch::Range;
+
+/**
+ * Helpers for the packed keep bitset stored in SimplifyScratch::keep.
+ */
+inline size_t keep_words(size_t n) { return (n + 63) / 64; }
+
+inline void set_keep(std::vector<uint64_t>& keep, size_t i) {
+    keep[i >> 6] |= uint64_t{1} << (i & 63);
+}
+
+inline bool test_keep(const std::vector<uint64_t>& keep, size_t i) {
+    return (keep[i >> 6] >> (i & 63)) & 1;
+}
+
 /**
  * Scalar baseline implementation of Douglas-Peucker simplification.
  * This is the reference implementation for correctness testing.
  * 
- * @param input Polyline to simplify
+ * @param input Polyline to simplify (at least 3 points)
  * @param tolerance Minimum distance tolerance
- * @return Simplified Polyline
+ * @param scratch Receives the keep bitset in scratch.keep
  */
-PolylineSoA simplify_scalar(const PolylineSoA& input, double tolerance);
+void simplify_scalar(const PolylineSoA& input, double tolerance, SimplifyScratch& scratch);
+
+#ifdef HAVE_SSE2
+/**
+ * SSE2 SIMD implementation of Douglas-Peucker simplification, for x86-64
+ * hosts without AVX. Uses 128-bit vectors to process 2 doubles at once.
+ * 
+ * @param input Polyline to simplify (at least 3 points)
+ * @param tolerance Minimum distance tolerance
+ * @param scratch Receives the keep bitset in scratch.keep
+ */
+void simplify_sse2(const PolylineSoA& input, double tolerance, SimplifyScratch& scratch);
+#endif
 
 #ifdef HAVE_AVX2
 /**
  * AVX2 SIMD implementation of Douglas-Peucker simplification.
  * Uses 256-bit vectors to process 4 doubles at once.
  * 
- * @param input Polyline to simplify
+ * @param input Polyline to simplify (at least 3 points)
  * @param tolerance Minimum distance tolerance
- * @return Simplified Polyline
+ * @param scratch Receives the keep bitset in scratch.keep
  */
-PolylineSoA simplify_avx2(const PolylineSoA& input, double tolerance);
+void simplify_avx2(const PolylineSoA& input, double tolerance, SimplifyScratch& scratch);
 #endif
 
 #ifdef HAVE_AVX512
@@ -32,11 +69,11 @@ PolylineSoA simplify_avx2(const PolylineSoA& input, double tolerance);
  * AVX-512 SIMD implementation of Douglas-Peucker simplification.
  * Uses 512-bit vectors to process 8 doubles at once.
  * 
- * @param input Polyline to simplify
+ * @param input Polyline to simplify (at least 3 points)
  * @param tolerance Minimum distance tolerance
- * @return Simplified Polyline
+ * @param scratch Receives the keep bitset in scratch.keep
  */
-PolylineSoA simplify_avx512(const PolylineSoA& input, double tolerance);
+void simplify_avx512(const PolylineSoA& input, double tolerance, SimplifyScratch& scratch);
 #endif
 
 #ifdef HAVE_NEON
@@ -44,13 +81,410 @@ PolylineSoA simplify_avx512(const PolylineSoA& input, double tolerance);
  * ARM NEON SIMD implementation of Douglas-Peucker simplification.
  * Uses 128-bit vectors to process 2 doubles at once.
  * 
- * @param input Polyline to simplify
+ * @param input Polyline to simplify (at least 3 points)
  * @param tolerance Minimum distance tolerance
- * @return Simplified Polyline
+ * @param scratch Receives the keep bitset in scratch.keep
+ */
+void simplify_neon(const PolylineSoA& input, double tolerance, SimplifyScratch& scratch);
+#endif
+
+/**
+ * Max-distance scans, one per ISA. Each returns the interior point of
+ * (start, end) farthest from the chord points[start] -> points[end],
+ * with ties going to the lowest index.
+ */
+FarthestPoint find_farthest_scalar(const PolylineSoA& points, size_t start, size_t end);
+
+#ifdef HAVE_SSE2
+FarthestPoint find_farthest_sse2(const PolylineSoA& points, size_t start, size_t end);
+#endif
+
+#ifdef HAVE_AVX2
+FarthestPoint find_farthest_avx2(const PolylineSoA& points, size_t start, size_t end);
+#endif
+
+#ifdef HAVE_AVX512
+FarthestPoint find_farthest_avx512(const PolylineSoA& points, size_t start, size_t end);
+#endif
+
+/// Max-distance scan entry point, for drivers that pick the ISA at runtime
+using FindFarthestFn = FarthestPoint (*)(const PolylineSoA& points, size_t start, size_t end);
+
+/**
+ * Single-precision max-distance scans. The key (cross^2, or point distance^2
+ * for a degenerate chord) is computed and compared in float on every ISA and
+ * divided by the chord's squared length once, after the argmax; ties go to
+ * the lowest index. Segments must span fewer than 2^31 points.
+ */
+FarthestPoint find_farthest_scalar_f32(const PolylineSoAf& points, size_t start, size_t end);
+
+#ifdef HAVE_AVX2
+FarthestPoint find_farthest_avx2_f32(const PolylineSoAf& points, size_t start, size_t end);
+#endif
+
+#ifdef HAVE_AVX512
+FarthestPoint find_farthest_avx512_f32(const PolylineSoAf& points, size_t start, size_t end);
+#endif
+
+using FindFarthestF32Fn = FarthestPoint (*)(const PolylineSoAf& points, size_t start, size_t end);
+
+/**
+ * Fixed-point max-distance scans. The key is |cross| as an exact int64 (or
+ * the squared point distance for a chord whose endpoints are equal), so
+ * every ISA ranks points identically; ties go to the lowest index. The
+ * squared distance is formed from the winning key by fixed_point_dist_sq().
+ * Coordinates must lie in [-2^30, 2^30).
+ */
+FarthestPoint find_farthest_scalar_i32(const PolylineSoAi& points, size_t start, size_t end);
+
+#ifdef HAVE_AVX2
+FarthestPoint find_farthest_avx2_i32(const PolylineSoAi& points, size_t start, size_t end);
+#endif
+
+#ifdef HAVE_AVX512
+FarthestPoint find_farthest_avx512_i32(const PolylineSoAi& points, size_t start, size_t end);
+#endif
+
+using FindFarthestI32Fn = FarthestPoint (*)(const PolylineSoAi& points, size_t start, size_t end);
+
+/**
+ * Squared distance for a fixed-point scan's winning key: key^2 / |chord|^2,
+ * or key itself when the chord is a point (chord_sq == 0).
+ */
+inline double fixed_point_dist_sq(int64_t key, int64_t chord_sq) {
+    if (chord_sq == 0) {
+        return static_cast<double>(key);
+    }
+    double k = static_cast<double>(key);
+    return k * k / static_cast<double>(chord_sq);
+}
+
+/**
+ * Compare-and-compress pass for simplify_by_significance(): copy the points
+ * with significance[i] > threshold to out_x/out_y (each sized >= n) and
+ * return how many were written.
+ */
+using FilterSignificantFn = size_t (*)(const double* x, const double* y, const double* significance,
+                                       size_t n, double threshold, double* out_x, double* out_y);
+
+size_t filter_significant_scalar(const double* x, const double* y, const double* significance,
+                                 size_t n, double threshold, double* out_x, double* out_y);
+
+#ifdef HAVE_SSE2
+size_t filter_significant_sse2(const double* x, const double* y, const double* significance,
+                               size_t n, double threshold, double* out_x, double* out_y);
+#endif
+
+#ifdef HAVE_AVX2
+size_t filter_significant_avx2(const double* x, const double* y, const double* significance,
+                               size_t n, double threshold, double* out_x, double* out_y);
+#endif
+
+#ifdef HAVE_AVX512
+size_t filter_significant_avx512(const double* x, const double* y, const double* significance,
+                                 size_t n, double threshold, double* out_x, double* out_y);
+#endif
+
+/**
+ * Initial Visvalingam-Whyatt effective areas: areas[i] is the area of the
+ * triangle (i - 1, i, i + 1) for interior points and +infinity for the two
+ * endpoints. Every ISA evaluates triangle_area()'s expression in the same
+ * order, so the areas are bit-identical across back ends. Requires n >= 3.
+ */
+using TriangleAreasFn = void (*)(const double* x, const double* y, size_t n, double* areas);
+
+void triangle_areas_scalar(const double* x, const double* y, size_t n, double* areas);
+
+#ifdef HAVE_SSE2
+void triangle_areas_sse2(const double* x, const double* y, size_t n, double* areas);
+#endif
+
+#ifdef HAVE_AVX2
+void triangle_areas_avx2(const double* x, const double* y, size_t n, double* areas);
+#endif
+
+#ifdef HAVE_AVX512
+void triangle_areas_avx512(const double* x, const double* y, size_t n, double* areas);
+#endif
+
+/**
+ * Segments with at least this many interior points (or a degenerate chord)
+ * are never packed by a level sweep; they get the per-segment scan instead.
+ */
+constexpr size_t kPackedMaxInterior = 32;
+
+/**
+ * Lane buffers for a packed level sweep, backed by SimplifyScratch and sized
+ * by simplify_breadth_first(). Sweeps only get the raw pointers, so no
+ * std::vector code is compiled with ISA flags (see simd.h).
+ *
+ * key, point and slot hold at least 8 lanes more than the sum over segs of
+ * min(interior points, kPackedMaxInterior - 1); last and segment hold at
+ * least count entries.
  */
-PolylineSoA simplify_neon(const PolylineSoA& input, double tolerance);
+struct PackedLanes {
+    double* key;       // Distance key per lane, then its running max
+    int64_t* point;    // Point index per lane, then its running argmax
+    int64_t* slot;     // Which packed segment each lane belongs to
+    size_t* last;      // Per packed segment: its last lane
+    size_t* segment;   // Per packed segment: index into segs / out
+};
+
+/**
+ * One level of breadth-first Douglas-Peucker: out[j] receives the farthest
+ * interior point of segs[j]. Segments are disjoint and sorted by start.
+ * lanes is working memory for sweeps that pack short segments.
+ */
+using SweepLevelFn = void (*)(const PolylineSoA& points, const Segment* segs, size_t count,
+                              FarthestPoint* out, const PackedLanes& lanes);
+
+void sweep_level_scalar(const PolylineSoA& points, const Segment* segs, size_t count,
+                        FarthestPoint* out, const PackedLanes& lanes);
+
+#ifdef HAVE_SSE2
+void sweep_level_sse2(const PolylineSoA& points, const Segment* segs, size_t count,
+                      FarthestPoint* out, const PackedLanes& lanes);
+#endif
+
+#ifdef HAVE_AVX2
+void sweep_level_avx2(const PolylineSoA& points, const Segment* segs, size_t count,
+                      FarthestPoint* out, const PackedLanes& lanes);
+#endif
+
+#ifdef HAVE_AVX512
+/**
+ * AVX-512 level sweep. Short segments are packed back to back so every
+ * lane does useful work however small the segments get, and each segment's
+ * argmax comes out of an in-register segmented scan.
+ */
+void sweep_level_avx512(const PolylineSoA& points, const Segment* segs, size_t count,
+                        FarthestPoint* out, const PackedLanes& lanes);
+#endif
+
+/**
+ * Strip scan for StreamingSimplifier: index of the first point whose
+ * cross product with the strip direction d, taken from key (kx, ky),
+ * satisfies cross^2 > limit, or n if every point is inside.
+ * cross = (x - kx) * dy - (y - ky) * dx, evaluated without FMA on every ISA.
+ */
+using FindExitFn = size_t (*)(const double* x, const double* y, size_t n,
+                              double kx, double ky, double dx, double dy, double limit);
+
+size_t find_exit_scalar(const double* x, const double* y, size_t n,
+                        double kx, double ky, double dx, double dy, double limit);
+
+#ifdef HAVE_SSE2
+size_t find_exit_sse2(const double* x, const double* y, size_t n,
+                      double kx, double ky, double dx, double dy, double limit);
+#endif
+
+#ifdef HAVE_AVX2
+size_t find_exit_avx2(const double* x, const double* y, size_t n,
+                      double kx, double ky, double dx, double dy, double limit);
+#endif
+
+#ifdef HAVE_AVX512
+size_t find_exit_avx512(const double* x, const double* y, size_t n,
+                        double kx, double ky, double dx, double dy, double limit);
+#endif
+
+/**
+ * Radial-distance pre-pass for SimplifyOptions::radial_prefilter: copies
+ * point 0, then every point more than sqrt(tolerance_sq) from the previously
+ * copied one, then point n - 1 if it wasn't copied already. Returns the number
+ * of points written; out_* must hold n elements (kernels may store whole
+ * vectors past the returned count). Distances are dx*dx + dy*dy without FMA
+ * on every ISA, so all back ends keep the same points.
+ */
+using RadialFilterFn = size_t (*)(const double* x, const double* y, size_t n,
+                                  double tolerance_sq, double* out_x, double* out_y);
+
+size_t radial_filter_scalar(const double* x, const double* y, size_t n,
+                            double tolerance_sq, double* out_x, double* out_y);
+
+#ifdef HAVE_SSE2
+size_t radial_filter_sse2(const double* x, const double* y, size_t n,
+                          double tolerance_sq, double* out_x, double* out_y);
+#endif
+
+#ifdef HAVE_AVX2
+size_t radial_filter_avx2(const double* x, const double* y, size_t n,
+                          double tolerance_sq, double* out_x, double* out_y);
+#endif
+
+#ifdef HAVE_AVX512
+size_t radial_filter_avx512(const double* x, const double* y, size_t n,
+                            double tolerance_sq, double* out_x, double* out_y);
 #endif
 
+/**
+ * Entry points of one back end, as picked by select_backend().
+ */
+struct SimplifyBackend {
+    void (*simplify)(const PolylineSoA& input, double tolerance, SimplifyScratch& scratch);
+    FindFarthestFn find_farthest;
+    FilterSignificantFn filter_significant;
+    TriangleAreasFn triangle_areas;
+    SweepLevelFn sweep_level;
+    FindExitFn find_exit;
+    RadialFilterFn radial_filter;
+    FindFarthestF32Fn find_farthest_f32;
+    FindFarthestI32Fn find_farthest_i32;
+};
+
+/**
+ * Resolve a SimplifyAlgorithm to its back end. AUTO picks by n, the number
+ * of points the call will process, against the current DispatchProfile.
+ * Throws std::runtime_error if the ISA isn't compiled in or the CPU lacks it.
+ */
+SimplifyBackend select_backend(SimplifyAlgorithm algorithm, size_t n);
+
+/**
+ * The back end AUTO picks for a call over n points under a given profile.
+ */
+SimplifyBackend auto_backend(size_t n, const DispatchProfile& profile);
+
+/**
+ * Parallel Douglas-Peucker. Both halves of every split larger than
+ * threshold points become tasks on the shared pool; smaller ranges are
+ * finished serially by the thread that picked them up. The keep set is the
+ * same as the serial driver's since it doesn't depend on visiting order.
+ *
+ * @param input Polyline to simplify (at least 3 points)
+ * @param tolerance Minimum distance tolerance
+ * @param scratch Receives the keep bitset in scratch.keep
+ * @param find_farthest Max-distance scan for the target ISA
+ * @param num_threads Pool size (0 = one per hardware thread)
+ * @param threshold Minimum range size, in points, that gets its own task
+ */
+void simplify_parallel(const PolylineSoA& input,
+                       double tolerance,
+                       SimplifyScratch& scratch,
+                       FindFarthestFn find_farthest,
+                       size_t num_threads,
+                       size_t threshold);
+
+/**
+ * Serial Douglas-Peucker with a given scan: simplify_with() compiled once,
+ * outside the ISA translation units. The work stack's std::vector growth is
+ * a weak symbol, and an ISA back end instantiating it could hand the linker
+ * a copy built with -mavx512f (see simd.h).
+ *
+ * @param input Polyline to simplify (at least 3 points)
+ * @param tolerance Minimum distance tolerance
+ * @param scratch Receives the keep bitset in scratch.keep
+ * @param find_farthest Max-distance scan for the target ISA
+ */
+void simplify_serial(const PolylineSoA& input,
+                     double tolerance,
+                     SimplifyScratch& scratch,
+                     FindFarthestFn find_farthest);
+
+/**
+ * Level-synchronous Douglas-Peucker. Every segment produced by one level of
+ * splits is scanned by a single sweep_level() call before any of their
+ * children are, so the per-segment overhead of short ranges can be batched.
+ * Ranges too big to stay in cache are split depth-first until they fit, then
+ * finished level by level. Same keep set as the depth-first driver.
+ *
+ * @param input Polyline to simplify (at least 3 points)
+ * @param tolerance Minimum distance tolerance
+ * @param scratch Receives the keep bitset in scratch.keep
+ * @param sweep_level Level sweep for the target ISA
+ */
+void simplify_breadth_first(const PolylineSoA& input,
+                            double tolerance,
+                            SimplifyScratch& scratch,
+                            SweepLevelFn sweep_level);
+
+/**
+ * Iterative Douglas-Peucker driver shared by every back end.
+ *
+ * Pending ranges live on a heap-allocated work stack instead of the call
+ * stack, so near-monotone inputs that split off one point per level can't
+ * overflow small worker-thread stacks. Only ranges with interior points are
+ * pushed and pending ranges never overlap, so the stack holds at most
+ * n - 2 entries (and usually far fewer).
+ *
+ * @param points Input points
+ * @param tolerance_sq Squared tolerance threshold
+ * @param keep Bitmask of which points to keep (endpoints must already be set)
+ * @param stack Work stack, cleared on entry; passed in so callers can reuse it
+ * @param find_farthest Max-distance scan for the target ISA
+ */
+template <typename T, typename FindFarthest>
+void douglas_peucker(const BasicPolylineSoA<T>& points,
+                     double tolerance_sq,
+                     std::vector<uint64_t>& keep,
+                     std::vector<Segment>& stack,
+                     FindFarthest&& find_farthest) {
+    stack.clear();
+    if (points.size() > 2) {
+        stack.push_back({0, points.size() - 1});
+    }
+
+    while (!stack.empty()) {
+        Segment seg = stack.back();
+        stack.pop_back();
+
+        FarthestPoint far = find_farthest(points, seg.start, seg.end);
+        if (far.dist_sq <= tolerance_sq) {
+            continue;
+        }
+
+        set_keep(keep, far.index);
+
+        // Push right first so the left half is processed next, same visiting
+        // order as the old recursion
+        if (seg.end > far.index + 1) {
+            stack.push_back({far.index, seg.end});
+        }
+        if (far.index > seg.start + 1) {
+            stack.push_back({seg.start, far.index});
+        }
+    }
+}
+
+/**
+ * Run the shared driver with a given scan, leaving the result in scratch.keep.
+ * Only touches the heap while the scratch buffers are still growing.
+ */
+template <typename T, typename FindFarthest>
+void simplify_with(const BasicPolylineSoA<T>& input,
+                   double tolerance,
+                   SimplifyScratch& scratch,
+                   FindFarthest&& find_farthest) {
+    // Square the tolerance to avoid sqrt in distance calculations
+    double tolerance_sq = tolerance * tolerance;
+
+    // Mark which points to keep
+    size_t n = input.size();
+    scratch.keep.assign(keep_words(n), 0);
+    set_keep(scratch.keep, 0);  // Always keep first point
+    set_keep(scratch.keep, n - 1);  // Always keep last point
+
+    douglas_peucker(input, tolerance_sq, scratch.keep, scratch.stack, find_farthest);
+}
+
+/**
+ * sweep_level() built from a per-segment scan, for ISAs without a packed sweep.
+ */
+template <typename FindFarthest>
+void sweep_level_with(const PolylineSoA& points, const Segment* segs, size_t count,
+                      FarthestPoint* out, FindFarthest&& find_farthest) {
+    for (size_t j = 0; j < count; ++j) {
+        out[j] = find_farthest(points, segs[j].start, segs[j].end);
+    }
+}
+
+/**
+ * Squared strip-distance key shared by find_exit_*() and StreamingSimplifier.
+ */
+inline double strip_cross_sq(double px, double py, double kx, double ky, double dx, double dy) {
+    double cross = (px - kx) * dy - (py - ky) * dx;
+    return cross * cross;
+}
+
 /**
  * Calculate perpendicular distance from a point to a line segment.
  * 
@@ -79,5 +513,16 @@ inline double perpendicular_distance(double px, double py,
     return (cross * cross) / mag_sq;
 }
 
+/**
+ * Area of the triangle (x0, y0), (x1, y1), (x2, y2).
+ * The SIMD area kernels mirror this expression operation for operation.
+ */
+inline double triangle_area(double x0, double y0,
+                            double x1, double y1,
+                            double x2, double y2) {
+    double cross = (x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0);
+    return 0.5 * std::fabs(cross);
+}
+
 } // namespace internal
 } // namespace geom
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace geom {
+namespace internal {
+
+/**
+ * A set of tasks that can be waited on together (fork-join).
+ * The first exception thrown by any task is rethrown from ThreadPool::wait().
+ */
+class TaskGroup {
+public:
+    TaskGroup() = default;
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+private:
+    friend class ThreadPool;
+
+    std::atomic<size_t> pending_{0};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+/**
+ * Small work-stealing thread pool.
+ *
+ * Every worker owns a deque: it pushes and pops its own tasks at the back
+ * (LIFO, cache-warm for fork-join) and steals from the front of the others
+ * (FIFO, so thieves take the oldest and usually biggest pieces). Tasks
+ * submitted from outside the pool land in a shared injector queue.
+ *
+ * A pool of concurrency N spawns N - 1 workers; the thread calling wait()
+ * runs tasks too and is the N-th participant. With N = 1 everything runs
+ * inline on the caller.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t concurrency);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Number of threads that run tasks, counting the waiting caller
+    size_t concurrency() const { return workers_.size() + 1; }
+
+    /**
+     * Queue a task as part of a group. Safe to call from inside a task,
+     * in which case the task goes to the current worker's own deque.
+     */
+    void submit(TaskGroup& group, Task task);
+
+    /**
+     * Run queued tasks on the calling thread until every task in the group
+     * has finished, then rethrow the first task exception, if any. Sleeps
+     * while the group's remaining tasks run on other threads.
+     */
+    void wait(TaskGroup& group);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::pair<TaskGroup*, Task>> tasks;
+    };
+
+    void worker_loop(size_t index);
+    bool try_run_one(size_t home);
+    bool pop_local(size_t index, std::pair<TaskGroup*, Task>& out);
+    bool steal(size_t thief, std::pair<TaskGroup*, Task>& out);
+    void run(std::pair<TaskGroup*, Task>& item);
+
+    // queues_[i] belongs to workers_[i]; the last queue is the injector
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::atomic<size_t> queued_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+};
+
+/**
+ * The process-wide pool, one thread per hardware thread. Created on first
+ * use and lives until exit. Calls that want fewer threads keep at most
+ * that many tasks in flight instead of getting a pool of their own.
+ */
+ThreadPool& shared_thread_pool();
+
+/**
+ * Threads a call asking for num_threads (0 = one per hardware thread) gets:
+ * never more than the shared pool has.
+ */
+size_t clamp_threads(size_t num_threads);
+
+} // namespace internal
+} // namespace geom
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "geom_simd/geom_simd.h"
+
+namespace geom {
+
+/**
+ * Online polyline simplification for traces that arrive point by point
+ * (Reumann-Witkam).
+ *
+ * The last emitted vertex (the key) and the first point after it define a
+ * line; following points are dropped while they stay within tolerance of
+ * that line. The first point to leave the strip finalizes the point before
+ * it, which becomes the new key. Every vertex is emitted as soon as it's
+ * known and state is a few doubles per trace, however long the trace gets.
+ *
+ * Unlike Douglas-Peucker this never looks back past the current key, so it
+ * keeps more points for the same tolerance.
+ *
+ * Feeding a trace through push() one point at a time or through push_many()
+ * in any chunking gives the same output.
+ */
+class StreamingSimplifier {
+public:
+    /**
+     * @param tolerance Maximum distance a dropped point can be from the
+     *                  line it was dropped against
+     * @param algorithm Which implementation push_many() uses for its scan
+     *
+     * @throws std::invalid_argument if tolerance <= 0
+     */
+    explicit StreamingSimplifier(double tolerance,
+                                 SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO);
+
+    /**
+     * Feed one point, appending any vertex it finalizes to output.
+     * @return Number of vertices appended (0 or 1)
+     */
+    size_t push(double x, double y, PolylineSoA& output);
+
+    /**
+     * Feed count points at once; the strip test runs in SIMD between
+     * emitted vertices.
+     * @return Number of vertices appended
+     */
+    size_t push_many(const double* x, const double* y, size_t count, PolylineSoA& output);
+
+    /**
+     * End the trace: append the pending last point, if any, and reset so the
+     * simplifier can take a new trace.
+     * @return Number of vertices appended (0 or 1)
+     */
+    size_t flush(PolylineSoA& output);
+
+    double tolerance() const { return tolerance_; }
+
+private:
+    // Start a new strip at the pending point, aimed at (x, y)
+    void rekey(double x, double y);
+
+    double tolerance_;
+    double tolerance_sq_;
+    SimplifyAlgorithm algorithm_;
+
+    // Last emitted vertex
+    double key_x_ = 0.0, key_y_ = 0.0;
+    // Strip direction and its squared-distance limit (tolerance^2 * |dir|^2)
+    double dir_x_ = 0.0, dir_y_ = 0.0, limit_ = 0.0;
+    // Most recent point, not emitted yet
+    double last_x_ = 0.0, last_y_ = 0.0;
+
+    bool has_key_ = false;
+    bool has_dir_ = false;
+    bool has_last_ = false;
+};
+
+} // namespace geom
@@ -0,0 +1,41 @@
+# Fails if a kernel object file defines a weak symbol.
+#
+# Usage: cmake -DNM=<nm> -P check_isa_symbols.cmake <object>...
+#
+# Inline functions and template instantiations (std::vector growth, say) are
+# emitted as weak definitions in every translation unit that uses them, and
+# the linker keeps whichever copy it sees first. A copy from a kernel built
+# with -mavx2 or -mavx512f can then run on a CPU without that ISA, so kernel
+# translation units must keep everything they instantiate internal.
+
+set(failed FALSE)
+set(objects "")
+# Arguments after the script name; RANGE is inclusive and never empty
+foreach(i RANGE 4 ${CMAKE_ARGC})
+    if(i LESS CMAKE_ARGC)
+        list(APPEND objects "${CMAKE_ARGV${i}}")
+    endif()
+endforeach()
+
+foreach(object IN LISTS objects)
+    execute_process(
+        COMMAND "${NM}" -C "${object}"
+        OUTPUT_VARIABLE symbols
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${NM} failed on ${object}")
+    endif()
+
+    # W / V: weak definitions; lowercase w / v are references and harmless
+    string(REGEX MATCHALL "[^\n]* [WV] [^\n]*" weak "${symbols}")
+    foreach(line IN LISTS weak)
+        message(SEND_ERROR "${object}: weak definition compiled with ISA flags:\n  ${line}")
+        set(failed TRUE)
+    endforeach()
+endforeach()
+
+if(failed)
+    message(FATAL_ERROR "Kernel translation units must not emit weak symbols, see "
+                        "include/geom_simd/internal/simd.h")
+endif()
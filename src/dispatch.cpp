@@ -0,0 +1,367 @@
+#include "geom_simd/geom_simd.h"
+#include "geom_simd/clip.h"
+#include "geom_simd/internal/intersect_internal.h"
+#include "geom_simd/internal/simplify_internal.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace geom {
+
+namespace {
+
+struct ProfileField {
+    const char* name;
+    size_t DispatchProfile::*member;
+};
+
+// Names used in profile files
+const ProfileField kProfileFields[] = {
+    {"avx2_min_points", &DispatchProfile::avx2_min_points},
+    {"avx512_min_points", &DispatchProfile::avx512_min_points},
+    {"neon_min_points", &DispatchProfile::neon_min_points},
+    {"sse2_min_points", &DispatchProfile::sse2_min_points},
+    {"parallel_min_points", &DispatchProfile::parallel_min_points},
+    {"intersect_simd_min_edges", &DispatchProfile::intersect_simd_min_edges},
+};
+
+constexpr size_t kProfileFieldCount = sizeof(kProfileFields) / sizeof(kProfileFields[0]);
+
+// The installed profile. Each threshold is its own relaxed atomic: a reader
+// racing set_dispatch_profile() may mix old and new values, which only
+// changes which kernels run, never the result.
+class ProfileState {
+public:
+    explicit ProfileState(const DispatchProfile& profile) { store(profile); }
+
+    void store(const DispatchProfile& profile) {
+        for (size_t i = 0; i < kProfileFieldCount; ++i) {
+            values_[i].store(profile.*kProfileFields[i].member, std::memory_order_relaxed);
+        }
+    }
+
+    DispatchProfile load() const {
+        DispatchProfile profile;
+        for (size_t i = 0; i < kProfileFieldCount; ++i) {
+            profile.*kProfileFields[i].member = values_[i].load(std::memory_order_relaxed);
+        }
+        return profile;
+    }
+
+private:
+    std::atomic<size_t> values_[kProfileFieldCount];
+};
+
+// Defaults, unless GEOM_SIMD_DISPATCH_PROFILE points at a profile file (or
+// at where one should be written)
+DispatchProfile initial_profile() {
+    const char* path = std::getenv("GEOM_SIMD_DISPATCH_PROFILE");
+    if (path == nullptr || *path == '\0') {
+        return DispatchProfile{};
+    }
+
+    try {
+        return load_dispatch_profile(path);
+    } catch (const std::runtime_error&) {
+        // Missing or stale, measure it again
+    }
+
+    DispatchProfile profile = calibrate_dispatch();
+    try {
+        save_dispatch_profile(profile, path);
+    } catch (const std::runtime_error&) {
+        // Still good for this process
+    }
+    return profile;
+}
+
+ProfileState& profile_state() {
+    static ProfileState state(initial_profile());
+    return state;
+}
+
+// --- Calibration ---
+
+constexpr auto kSampleTime = std::chrono::microseconds(100);
+constexpr auto kBatchTime = std::chrono::microseconds(2);
+constexpr int kSamples = 5;
+constexpr size_t kMaxCallsPerClockRead = 16;
+
+// Best time per call of fn in nanoseconds. Minimum over several samples,
+// since noise only ever adds time. Calls shorter than kBatchTime are
+// batched between clock reads so the clock doesn't swamp them; anything
+// longer is read after every call, so a sample of an expensive call is
+// just that one call and the whole measurement costs kSamples + 1 calls.
+template <typename Fn>
+double time_per_call(Fn&& fn) {
+    using Clock = std::chrono::steady_clock;
+
+    // Warm caches and grow any scratch; also sizes the batches
+    auto warm_start = Clock::now();
+    fn();
+    auto warm = Clock::now() - warm_start;
+
+    size_t batch = kMaxCallsPerClockRead;
+    if (warm * batch > kBatchTime) {
+        batch = static_cast<size_t>(std::max<Clock::rep>(1, kBatchTime / warm));
+    }
+
+    double best = std::numeric_limits<double>::infinity();
+    for (int sample = 0; sample < kSamples; ++sample) {
+        size_t calls = 0;
+        auto start = Clock::now();
+        Clock::duration elapsed;
+        do {
+            for (size_t i = 0; i < batch; ++i) {
+                fn();
+            }
+            calls += batch;
+            elapsed = Clock::now() - start;
+        } while (elapsed < kSampleTime);
+
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        best = std::min(best, ns / static_cast<double>(calls));
+    }
+    return best;
+}
+
+// Index of the first of count sizes from which `wide` is at least as fast
+// as `narrow` at every larger size too; count if it loses at the largest
+size_t crossover(size_t count, const std::vector<double>& wide,
+                 const std::vector<double>& narrow) {
+    size_t from = count;
+    while (from > 0 && wide[from - 1] <= narrow[from - 1]) {
+        --from;
+    }
+    return from;
+}
+
+// Meandering trace: unit-ish steps with a wandering heading, like a road
+// or a coastline. At tolerance 1 Douglas-Peucker drops most of it, so the
+// timings mix long scans near the top of the split tree with short ones
+// further down, as real lines do.
+PolylineSoA calibration_line(size_t n) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<double> turn(-0.3, 0.3);
+    std::uniform_real_distribution<double> step(0.5, 2.0);
+
+    PolylineSoA line;
+    line.reserve(n);
+    double x = 0.0, y = 0.0, heading = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        line.push_back(x, y);
+        heading += turn(rng);
+        double length = step(rng);
+        x += length * std::cos(heading);
+        y += length * std::sin(heading);
+    }
+    return line;
+}
+
+struct SimplifyTier {
+    SimplifyAlgorithm algorithm;
+    bool available;
+    size_t DispatchProfile::*min_points;
+};
+
+void calibrate_simplify(DispatchProfile& profile) {
+    constexpr double kTolerance = 1.0;
+    const size_t sizes[] = {4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096};
+    constexpr size_t kSizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    std::vector<PolylineSoA> lines;
+    for (size_t n : sizes) {
+        lines.push_back(calibration_line(n));
+    }
+
+    SimplifyScratch scratch;
+    auto time_backend = [&](const internal::SimplifyBackend& backend) {
+        std::vector<double> times(kSizes);
+        for (size_t i = 0; i < kSizes; ++i) {
+            times[i] = time_per_call([&] { backend.simplify(lines[i], kTolerance, scratch); });
+        }
+        return times;
+    };
+
+    // Narrow to wide, the reverse of AUTO's preference order
+    auto caps = get_simd_capabilities();
+    const SimplifyTier tiers[] = {
+        {SimplifyAlgorithm::NEON, caps.neon_available, &DispatchProfile::neon_min_points},
+        {SimplifyAlgorithm::SSE2, caps.sse2_available, &DispatchProfile::sse2_min_points},
+        {SimplifyAlgorithm::AVX2, caps.avx2_available, &DispatchProfile::avx2_min_points},
+        {SimplifyAlgorithm::AVX512, caps.avx512_available, &DispatchProfile::avx512_min_points},
+    };
+
+    // What AUTO picks at each size so far; each wider tier has to beat it
+    std::vector<double> best =
+        time_backend(internal::select_backend(SimplifyAlgorithm::SCALAR, 0));
+    for (const SimplifyTier& tier : tiers) {
+        if (!tier.available) {
+            continue;
+        }
+
+        std::vector<double> times = time_backend(internal::select_backend(tier.algorithm, 0));
+        size_t from = crossover(kSizes, times, best);
+
+        // Winning at the smallest size measured means winning at every size
+        size_t min_points = from == kSizes ? SIZE_MAX : (from == 0 ? 0 : sizes[from]);
+        profile.*tier.min_points = min_points;
+
+        for (size_t i = from; i < kSizes; ++i) {
+            best[i] = times[i];
+        }
+    }
+}
+
+// Runs after calibrate_simplify(), so the serial side uses the ISA the new
+// thresholds pick. Never touches the installed profile: this can run while
+// it's being initialized.
+void calibrate_parallel(DispatchProfile& profile) {
+    if (std::thread::hardware_concurrency() <= 1) {
+        return;
+    }
+
+    // Capped at 2^18 points: each size costs 12 simplify calls (6 serial,
+    // 6 parallel), and a million-point line would take most of a second on
+    // its own. Lines past the largest size are still parallel if it wins.
+    constexpr double kTolerance = 1.0;
+    const size_t sizes[] = {size_t{1} << 16, size_t{1} << 17, size_t{1} << 18};
+    constexpr size_t kSizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    SimplifyScratch scratch;
+    size_t threshold = SimplifyOptions{}.parallel_threshold;
+    std::vector<double> serial(kSizes), parallel(kSizes);
+    for (size_t i = 0; i < kSizes; ++i) {
+        PolylineSoA line = calibration_line(sizes[i]);
+        internal::SimplifyBackend backend = internal::auto_backend(sizes[i], profile);
+
+        serial[i] = time_per_call([&] { backend.simplify(line, kTolerance, scratch); });
+        parallel[i] = time_per_call([&] {
+            internal::simplify_parallel(line, kTolerance, scratch, backend.find_farthest,
+                                        0, threshold);
+        });
+    }
+
+    size_t from = crossover(kSizes, parallel, serial);
+    profile.parallel_min_points = from == kSizes ? SIZE_MAX : sizes[from];
+}
+
+void calibrate_intersect(DispatchProfile& profile) {
+    const intersect::internal::IntersectBackend& backend =
+        intersect::internal::intersect_backend();
+    if (backend.range == intersect::internal::edge_range_scalar) {
+        return;  // Nothing to choose between
+    }
+
+    const size_t sizes[] = {1, 2, 4, 8, 16, 32, 64, 128, 256};
+    constexpr size_t kSizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<double> coord(0.0, 100.0);
+    PolylineSoA edges;
+    for (size_t i = 0; i <= sizes[kSizes - 1]; ++i) {
+        edges.push_back(coord(rng), coord(rng));
+    }
+    Point a1(0.0, 50.0), a2(100.0, 50.0);
+    std::vector<intersect::EdgeIntersection> results(sizes[kSizes - 1]);
+
+    std::vector<double> scalar(kSizes), simd(kSizes);
+    for (size_t i = 0; i < kSizes; ++i) {
+        scalar[i] = time_per_call([&] {
+            intersect::internal::edge_range_scalar(a1, a2, edges, 0, sizes[i], results.data());
+        });
+        simd[i] = time_per_call([&] {
+            backend.range(a1, a2, edges, 0, sizes[i], results.data());
+        });
+    }
+
+    size_t from = crossover(kSizes, simd, scalar);
+    profile.intersect_simd_min_edges = from == kSizes ? SIZE_MAX : (from == 0 ? 0 : sizes[from]);
+}
+
+} // anonymous namespace
+
+DispatchProfile calibrate_dispatch() {
+    DispatchProfile profile;
+    calibrate_simplify(profile);
+    calibrate_parallel(profile);
+    calibrate_intersect(profile);
+    return profile;
+}
+
+void set_dispatch_profile(const DispatchProfile& profile) {
+    profile_state().store(profile);
+}
+
+DispatchProfile get_dispatch_profile() {
+    return profile_state().load();
+}
+
+void save_dispatch_profile(const DispatchProfile& profile, const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot open dispatch profile for writing: " + path);
+    }
+
+    out << "# geom_simd dispatch profile\n";
+    for (const ProfileField& field : kProfileFields) {
+        out << field.name << ' ' << profile.*field.member << '\n';
+    }
+
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Failed to write dispatch profile: " + path);
+    }
+}
+
+DispatchProfile load_dispatch_profile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open dispatch profile: " + path);
+    }
+
+    DispatchProfile profile;
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(in, line)) {
+        ++line_number;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        std::string name, value, extra;
+        fields >> name >> value;
+        bool is_number = !value.empty() &&
+                         value.find_first_not_of("0123456789") == std::string::npos;
+        if (!is_number || (fields >> extra)) {
+            throw std::runtime_error("Malformed dispatch profile " + path + ", line " +
+                                     std::to_string(line_number));
+        }
+
+        // Unknown names are skipped, so older builds can read newer profiles
+        for (const ProfileField& field : kProfileFields) {
+            if (name == field.name) {
+                try {
+                    profile.*field.member = static_cast<size_t>(std::stoull(value));
+                } catch (const std::out_of_range&) {
+                    throw std::runtime_error("Out of range value in dispatch profile " + path +
+                                             ", line " + std::to_string(line_number));
+                }
+            }
+        }
+    }
+
+    return profile;
+}
+
+} // namespace geom
@@ -0,0 +1,385 @@
+#include "geom_simd/clip.h"
+#include "geom_simd/internal/intersect_internal.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace geom {
+namespace intersect {
+
+namespace internal {
+
+namespace {
+
+const IntersectBackend kScalarBackend = {
+    edge_range_scalar, edge_range_scalar_f32, edge_range_scalar_i32, edge_batch_scalar,
+    edge_tile_scalar,
+};
+
+#ifdef HAVE_SSE2
+// Double only; float and fixed-point edges gain little at 2 lanes
+const IntersectBackend kSse2Backend = {
+    edge_range_sse2, edge_range_scalar_f32, edge_range_scalar_i32, edge_batch_sse2,
+    edge_tile_sse2,
+};
+#endif
+
+#ifdef HAVE_AVX2
+const IntersectBackend kAvx2Backend = {
+    edge_range_avx2, edge_range_avx2_f32, edge_range_avx2_i32, edge_batch_avx2,
+    edge_tile_avx2,
+};
+#endif
+
+#ifdef HAVE_AVX512
+const IntersectBackend kAvx512Backend = {
+    edge_range_avx512, edge_range_avx512_f32, edge_range_avx512_i32,
+    edge_batch_avx512, edge_tile_avx512,
+};
+#endif
+
+const IntersectBackend& detect_backend() {
+    auto caps = get_simd_capabilities();
+
+#ifdef HAVE_AVX512
+    if (caps.avx512_available) {
+        return kAvx512Backend;
+    }
+#endif
+#ifdef HAVE_AVX2
+    if (caps.avx2_available) {
+        return kAvx2Backend;
+    }
+#endif
+#ifdef HAVE_SSE2
+    if (caps.sse2_available) {
+        return kSse2Backend;
+    }
+#endif
+    (void)caps;
+    return kScalarBackend;
+}
+
+} // anonymous namespace
+
+const IntersectBackend& intersect_backend() {
+    static const IntersectBackend& backend = detect_backend();
+    return backend;
+}
+
+namespace {
+
+// Short ranges stay in the scalar loop below the profile's crossover
+const IntersectBackend& range_backend(size_t count) {
+    if (count < get_dispatch_profile().intersect_simd_min_edges) {
+        return kScalarBackend;
+    }
+    return intersect_backend();
+}
+
+// Explicit choices throw like simplify() does when the ISA is missing
+const IntersectBackend& select_backend(SimplifyAlgorithm algorithm, size_t count) {
+    auto caps = get_simd_capabilities();
+    (void)caps;
+
+    switch (algorithm) {
+        case SimplifyAlgorithm::AUTO:
+            return range_backend(count);
+
+        case SimplifyAlgorithm::SCALAR:
+            return kScalarBackend;
+
+#ifdef HAVE_SSE2
+        case SimplifyAlgorithm::SSE2:
+            if (!caps.sse2_available) {
+                throw std::runtime_error("SSE2 not available on this CPU");
+            }
+            return kSse2Backend;
+#endif
+
+#ifdef HAVE_AVX2
+        case SimplifyAlgorithm::AVX2:
+            if (!caps.avx2_available) {
+                throw std::runtime_error("AVX2 not available on this CPU");
+            }
+            return kAvx2Backend;
+#endif
+
+#ifdef HAVE_AVX512
+        case SimplifyAlgorithm::AVX512:
+            if (!caps.avx512_available) {
+                throw std::runtime_error("AVX512 not available on this CPU");
+            }
+            return kAvx512Backend;
+#endif
+
+        default:
+            throw std::runtime_error("No intersection kernels for this algorithm in this build");
+    }
+}
+
+// B edges per block: one batch call and one bounding-box test each
+constexpr size_t kBlockEdges = 64;
+
+struct Box {
+    double min_x, min_y, max_x, max_y;
+};
+
+Box edge_box(double x1, double y1, double x2, double y2) {
+    return {std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2)};
+}
+
+bool boxes_overlap(const Box& a, const Box& b) {
+    return a.min_x <= b.max_x && b.min_x <= a.max_x &&
+           a.min_y <= b.max_y && b.min_y <= a.max_y;
+}
+
+// Edges stored as consecutive vertices, not counting an open ring's closing edge
+size_t stored_edges(const Polygon& polygon) {
+    return polygon.size() < 2 ? 0 : polygon.size() - 1;
+}
+
+bool has_closing_edge(const Polygon& polygon) {
+    return polygon.size() >= 3 && !polygon.is_closed();
+}
+
+// Cache blocks for the tile kernels, in edges. A block of A (16 bytes a
+// vertex) is streamed once per tile of B, so 8 KB of it stays in L1; a
+// block of B is re-read once per block of A, so 128 KB of it stays in L2.
+constexpr size_t kTileAEdges = 512;
+constexpr size_t kTileBEdges = 8192;
+
+// Free slots kept at the end of the hit list before each tile call; a tile
+// with more hits than that is rare and just runs twice
+constexpr size_t kTileSpareHits = 1024;
+
+size_t polyline_edges(const PolylineSoA& vertices) {
+    return vertices.size() < 2 ? 0 : vertices.size() - 1;
+}
+
+} // anonymous namespace
+
+} // namespace internal
+
+std::vector<EdgeHit> find_all_intersections(
+    const Polygon& a,
+    const Polygon& b,
+    SimplifyAlgorithm algorithm
+) {
+    using internal::kBlockEdges;
+
+    const PolylineSoA& av = a.vertices;
+    const PolylineSoA& bv = b.vertices;
+    size_t a_edges = internal::stored_edges(a) + (internal::has_closing_edge(a) ? 1 : 0);
+    size_t b_stored = internal::stored_edges(b);
+    bool b_closing = internal::has_closing_edge(b);
+
+    // Every batch call is one block, so that's the length AUTO weighs
+    const internal::IntersectBackend& backend =
+        internal::select_backend(algorithm, std::min(b_stored, kBlockEdges));
+
+    // Bounding box of each block of B's stored edges
+    size_t b_blocks = (b_stored + kBlockEdges - 1) / kBlockEdges;
+    std::vector<internal::Box> block_boxes(b_blocks);
+    for (size_t block = 0; block < b_blocks; ++block) {
+        size_t first = block * kBlockEdges;
+        size_t last = std::min(first + kBlockEdges, b_stored);
+        internal::Box box{bv.x[first], bv.y[first], bv.x[first], bv.y[first]};
+        for (size_t j = first + 1; j <= last; ++j) {
+            box.min_x = std::min(box.min_x, bv.x[j]);
+            box.min_y = std::min(box.min_y, bv.y[j]);
+            box.max_x = std::max(box.max_x, bv.x[j]);
+            box.max_y = std::max(box.max_y, bv.y[j]);
+        }
+        block_boxes[block] = box;
+    }
+
+    std::vector<EdgeHit> hits;
+    constexpr size_t kColumn = kBlockEdges + internal::kBatchSlack;
+    double t[kColumn], u[kColumn], x[kColumn], y[kColumn];
+    size_t edge[kColumn];
+
+    for (size_t i = 0; i < a_edges; ++i) {
+        size_t i_next = (i + 1 < av.size()) ? i + 1 : 0;
+        Point a1{av.x[i], av.y[i]};
+        Point a2{av.x[i_next], av.y[i_next]};
+        internal::Box a_box = internal::edge_box(a1.x, a1.y, a2.x, a2.y);
+
+        for (size_t block = 0; block < b_blocks; ++block) {
+            if (!internal::boxes_overlap(a_box, block_boxes[block])) {
+                continue;
+            }
+            size_t first = block * kBlockEdges;
+            size_t count = std::min(kBlockEdges, b_stored - first);
+            size_t found = backend.batch(a1, a2, bv, first, count, t, u, x, y, edge);
+            for (size_t k = 0; k < found; ++k) {
+                hits.push_back({i, edge[k], t[k], u[k], x[k], y[k]});
+            }
+        }
+
+        if (b_closing) {
+            size_t last = bv.size() - 1;
+            auto r = edge_intersect_scalar(a1, a2, {bv.x[last], bv.y[last]}, {bv.x[0], bv.y[0]});
+            if (r.intersects) {
+                hits.push_back({i, last, r.t, r.u, r.x, r.y});
+            }
+        }
+    }
+
+    return hits;
+}
+
+std::vector<EdgeHit> find_all_intersections(
+    const PolylineSoA& a,
+    const PolylineSoA& b,
+    SimplifyAlgorithm algorithm
+) {
+    using internal::kTileAEdges;
+    using internal::kTileBEdges;
+
+    size_t a_edges = internal::polyline_edges(a);
+    size_t b_edges = internal::polyline_edges(b);
+    const internal::IntersectBackend& backend = internal::select_backend(algorithm, b_edges);
+
+    // The kernels write into spare room at the end of hits and report how
+    // many they found; a tile that didn't fit is run again with room for all
+    std::vector<EdgeHit> hits;
+    size_t n = 0;
+    for (size_t b_first = 0; b_first < b_edges; b_first += kTileBEdges) {
+        size_t b_count = std::min(kTileBEdges, b_edges - b_first);
+        for (size_t a_first = 0; a_first < a_edges; a_first += kTileAEdges) {
+            size_t a_count = std::min(kTileAEdges, a_edges - a_first);
+            if (hits.size() - n < internal::kTileSpareHits) {
+                hits.resize(std::max(2 * hits.size(), n + internal::kTileSpareHits));
+            }
+            size_t found = backend.tile(a, a_first, a_count, b, b_first, b_count,
+                                        hits.data() + n, hits.size() - n);
+            if (found > hits.size() - n) {
+                hits.resize(n + found);
+                backend.tile(a, a_first, a_count, b, b_first, b_count, hits.data() + n, found);
+            }
+            n += found;
+        }
+    }
+    hits.resize(n);
+
+    // The kernels emit tile by tile
+    std::sort(hits.begin(), hits.end(), [](const EdgeHit& lhs, const EdgeHit& rhs) {
+        return lhs.a_edge != rhs.a_edge ? lhs.a_edge < rhs.a_edge : lhs.b_edge < rhs.b_edge;
+    });
+    return hits;
+}
+
+void edge_intersect_range(
+    const Point& a1, const Point& a2,
+    const PolylineSoA& b_vertices,
+    size_t start_idx,
+    size_t count,
+    EdgeIntersection* results
+) {
+    internal::range_backend(count).range(a1, a2, b_vertices, start_idx, count, results);
+}
+
+void edge_intersect_range(
+    const Point& a1, const Point& a2,
+    const PolylineSoAf& b_vertices,
+    size_t start_idx,
+    size_t count,
+    EdgeIntersection* results
+) {
+    internal::range_backend(count).range_f32(a1, a2, b_vertices, start_idx, count, results);
+}
+
+void edge_intersect_range(
+    const PointI& a1, const PointI& a2,
+    const PolylineSoAi& b_vertices,
+    size_t start_idx,
+    size_t count,
+    EdgeIntersection* results
+) {
+    internal::range_backend(count).range_i32(a1, a2, b_vertices, start_idx, count, results);
+}
+
+size_t edge_intersect_batch(
+    const Point& a1, const Point& a2,
+    const PolylineSoA& b_vertices,
+    size_t start_idx,
+    size_t count,
+    EdgeHitsSoA& out
+) {
+    // Room for every edge to hit plus a full vector store, grown
+    // geometrically so repeated batches settle at one allocation
+    size_t needed = out.count + count + internal::kBatchSlack;
+    if (out.t.size() < needed) {
+        size_t grown = std::max(needed, 2 * out.t.size());
+        out.t.resize(grown);
+        out.u.resize(grown);
+        out.x.resize(grown);
+        out.y.resize(grown);
+        out.edge.resize(grown);
+    }
+    
+    size_t n = out.count;
+    size_t hits = internal::range_backend(count).batch(
+        a1, a2, b_vertices, start_idx, count,
+        &out.t[n], &out.u[n], &out.x[n], &out.y[n], &out.edge[n]);
+    out.count += hits;
+    return hits;
+}
+
+// The fixed-width kernels are declared in every build; ISAs this build
+// doesn't contain get stubs so callers still link
+#ifndef HAVE_AVX512
+void edge_intersect_avx512(const Point&, const Point&, const PolylineSoA&, size_t,
+                           EdgeIntersection[8]) {
+    throw std::runtime_error("AVX-512 kernels not compiled into this build");
+}
+
+void edge_intersect_avx512_masked(const Point&, const Point&, const PolylineSoA&, size_t, size_t,
+                                  EdgeIntersection[8]) {
+    throw std::runtime_error("AVX-512 kernels not compiled into this build");
+}
+
+void edge_intersect_avx512(const Point&, const Point&, const PolylineSoAf&, size_t,
+                           EdgeIntersection[16]) {
+    throw std::runtime_error("AVX-512 kernels not compiled into this build");
+}
+
+void edge_intersect_avx512_i32(const PointI&, const PointI&, const PolylineSoAi&, size_t,
+                               EdgeIntersection[8]) {
+    throw std::runtime_error("AVX-512 kernels not compiled into this build");
+}
+#endif
+
+#ifndef HAVE_AVX2
+void edge_intersect_avx2(double, double, double, double, const PolylineSoA&, size_t,
+                         EdgeIntersection[4]) {
+    throw std::runtime_error("AVX2 kernels not compiled into this build");
+}
+
+void edge_intersect_avx2(const Point&, const Point&, const PolylineSoAf&, size_t,
+                         EdgeIntersection[8]) {
+    throw std::runtime_error("AVX2 kernels not compiled into this build");
+}
+
+void edge_intersect_avx2_i32(const PointI&, const PointI&, const PolylineSoAi&, size_t,
+                             EdgeIntersection[4]) {
+    throw std::runtime_error("AVX2 kernels not compiled into this build");
+}
+#endif
+
+#ifndef HAVE_SSE2
+void edge_intersect_sse2(const Point&, const Point&, const PolylineSoA&, size_t,
+                         EdgeIntersection[2]) {
+    throw std::runtime_error("SSE2 kernels not compiled into this build");
+}
+#endif
+
+#ifndef HAVE_NEON
+void edge_intersect_neon(double, double, double, double, const PolylineSoA&, size_t,
+                         EdgeIntersection[2]) {
+    throw std::runtime_error("NEON kernels not compiled into this build");
+}
+#endif
+
+} // namespace intersect
+} // namespace geom
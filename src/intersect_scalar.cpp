@@ -1,4 +1,5 @@
 #include "geom_simd/clip.h"
+#include "geom_simd/internal/intersect_internal.h"
 #include <cmath>
 
 namespace geom {
@@ -45,26 +46,161 @@ EdgeIntersection edge_intersect_scalar(
     double dx_ab = b1.x - a1.x;  // B1 - A1
     double dy_ab = b1.y - a1.y;
     
-    // Calculate t and u
     // t = (B1 - A1) × (B2 - B1) / denominator
-    double numerator_t = dx_ab * dy_b - dy_ab * dx_b;
-    double t = numerator_t / denominator;
-    
     // u = (B1 - A1) × (A2 - A1) / denominator
+    double numerator_t = dx_ab * dy_b - dy_ab * dx_b;
     double numerator_u = dx_ab * dy_a - dy_ab * dx_a;
+    
+    // Check if intersection point is within both segments before dividing:
+    // with the signs flipped to make the denominator positive, t and u are
+    // in [0, 1] iff their numerators are in [0, denominator]. The decision
+    // is made on the numerators, not on rounded quotients. It differs from
+    // testing 0 <= t <= 1 after dividing when a tiny numerator of the wrong
+    // sign divides to -0: that passed t >= 0, and is rejected here. A
+    // numerator one ulp past the denominator is rejected by both, since
+    // its correctly rounded quotient is above 1.
+    double magnitude = std::abs(denominator);
+    double sign = std::copysign(1.0, denominator);  // Exact, and no branch
+    double scaled_t = numerator_t * sign;
+    double scaled_u = numerator_u * sign;
+    if (!(scaled_t >= 0.0 && scaled_t <= magnitude && scaled_u >= 0.0 && scaled_u <= magnitude)) {
+        return EdgeIntersection();  // No intersection within segments
+    }
+    
+    double t = numerator_t / denominator;
     double u = numerator_u / denominator;
     
-    // Check if intersection point is within both segments
-    if (t >= 0.0 && t <= 1.0 && u >= 0.0 && u <= 1.0) {
-        // Calculate intersection point using parameter t on edge A
-        double ix = a1.x + t * dx_a;
-        double iy = a1.y + t * dy_a;
-        
-        return EdgeIntersection(true, t, u, ix, iy);
+    // Calculate intersection point using parameter t on edge A
+    double ix = a1.x + t * dx_a;
+    double iy = a1.y + t * dy_a;
+    
+    return EdgeIntersection(true, t, u, ix, iy);
+}
+
+EdgeIntersection edge_intersect_scalar_i32(
+    const PointI& a1, const PointI& a2,
+    const PointI& b1, const PointI& b2
+) {
+    // Differences fit in 32 bits and products in 64 for coordinates in
+    // [-2^30, 2^30), so everything up to the range checks is exact
+    int64_t dx_a = int64_t{a2.x} - a1.x;
+    int64_t dy_a = int64_t{a2.y} - a1.y;
+    int64_t dx_b = int64_t{b2.x} - b1.x;
+    int64_t dy_b = int64_t{b2.y} - b1.y;
+    int64_t dx_ab = int64_t{b1.x} - a1.x;
+    int64_t dy_ab = int64_t{b1.y} - a1.y;
+    
+    int64_t denominator = dx_a * dy_b - dy_a * dx_b;
+    if (denominator == 0) {
+        return EdgeIntersection();  // Parallel or collinear
     }
     
-    return EdgeIntersection();  // No intersection within segments
+    int64_t numerator_t = dx_ab * dy_b - dy_ab * dx_b;
+    int64_t numerator_u = dx_ab * dy_a - dy_ab * dx_a;
+    
+    // t = numerator_t / denominator is in [0, 1] iff 0 <= numerator_t <= denominator
+    // once the denominator is made positive; same for u
+    if (denominator < 0) {
+        denominator = -denominator;
+        numerator_t = -numerator_t;
+        numerator_u = -numerator_u;
+    }
+    if (numerator_t < 0 || numerator_t > denominator ||
+        numerator_u < 0 || numerator_u > denominator) {
+        return EdgeIntersection();
+    }
+    
+    return internal::fixed_point_hit(a1, a2, numerator_t, numerator_u, denominator);
+}
+
+namespace internal {
+
+EdgeIntersection fixed_point_hit(const PointI& a1, const PointI& a2,
+                                 int64_t numerator_t, int64_t numerator_u,
+                                 int64_t denominator) {
+    double t = static_cast<double>(numerator_t) / static_cast<double>(denominator);
+    double u = static_cast<double>(numerator_u) / static_cast<double>(denominator);
+    return EdgeIntersection(true, t, u,
+                            a1.x + t * static_cast<double>(int64_t{a2.x} - a1.x),
+                            a1.y + t * static_cast<double>(int64_t{a2.y} - a1.y));
+}
+
+} // namespace internal
+
+namespace internal {
+
+void edge_range_scalar(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                       size_t start_idx, size_t count, EdgeIntersection* results) {
+    for (size_t i = 0; i < count; ++i) {
+        size_t e = start_idx + i;
+        results[i] = edge_intersect_scalar(a1, a2,
+                                           {b_vertices.x[e], b_vertices.y[e]},
+                                           {b_vertices.x[e + 1], b_vertices.y[e + 1]});
+    }
 }
 
+size_t edge_batch_scalar(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                         size_t start_idx, size_t count, double* t, double* u,
+                         double* x, double* y, size_t* edge) {
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t e = start_idx + i;
+        auto r = edge_intersect_scalar(a1, a2,
+                                       {b_vertices.x[e], b_vertices.y[e]},
+                                       {b_vertices.x[e + 1], b_vertices.y[e + 1]});
+        if (r.intersects) {
+            t[n] = r.t;
+            u[n] = r.u;
+            x[n] = r.x;
+            y[n] = r.y;
+            edge[n] = e;
+            ++n;
+        }
+    }
+    return n;
+}
+
+size_t edge_tile_scalar(const PolylineSoA& a, size_t a_first, size_t a_count,
+                        const PolylineSoA& b, size_t b_first, size_t b_count,
+                        EdgeHit* hits, size_t capacity) {
+    size_t n = 0;
+    for (size_t i = a_first; i < a_first + a_count; ++i) {
+        Point a1{a.x[i], a.y[i]};
+        Point a2{a.x[i + 1], a.y[i + 1]};
+        for (size_t j = b_first; j < b_first + b_count; ++j) {
+            auto r = edge_intersect_scalar(a1, a2, {b.x[j], b.y[j]}, {b.x[j + 1], b.y[j + 1]});
+            if (r.intersects) {
+                if (n < capacity) {
+                    hits[n] = {i, j, r.t, r.u, r.x, r.y};
+                }
+                ++n;
+            }
+        }
+    }
+    return n;
+}
+
+void edge_range_scalar_f32(const Point& a1, const Point& a2, const PolylineSoAf& b_vertices,
+                           size_t start_idx, size_t count, EdgeIntersection* results) {
+    for (size_t i = 0; i < count; ++i) {
+        size_t e = start_idx + i;
+        results[i] = edge_intersect_scalar(a1, a2,
+                                           {b_vertices.x[e], b_vertices.y[e]},
+                                           {b_vertices.x[e + 1], b_vertices.y[e + 1]});
+    }
+}
+
+void edge_range_scalar_i32(const PointI& a1, const PointI& a2, const PolylineSoAi& b_vertices,
+                           size_t start_idx, size_t count, EdgeIntersection* results) {
+    for (size_t i = 0; i < count; ++i) {
+        size_t e = start_idx + i;
+        results[i] = edge_intersect_scalar_i32(a1, a2,
+                                               {b_vertices.x[e], b_vertices.y[e]},
+                                               {b_vertices.x[e + 1], b_vertices.y[e + 1]});
+    }
+}
+
+} // namespace internal
+
 } // namespace intersect
 } // namespace geom
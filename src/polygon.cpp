@@ -1,9 +1,21 @@
 #include "geom_simd/polygon.h"
+#include "geom_simd/internal/simd_kernels.h"
 #include <cmath>
 #include <algorithm>
 
 namespace geom {
 
+namespace {
+
+// SSE2 is part of x86-64 itself, so these need no runtime dispatch
+#ifdef __SSE2__
+constexpr size_t kPolygonWidth = 2;
+#else
+constexpr size_t kPolygonWidth = 1;
+#endif
+
+} // anonymous namespace
+
 bool Polygon::is_closed() const {
     if (vertices.size() < 2) return false;
     
@@ -18,16 +30,14 @@ double Polygon::signed_area() const {
     if (vertices.size() < 3) return 0.0;
     
     // Shoelace formula: 0.5 * sum(x[i] * y[i+1] - x[i+1] * y[i])
-    double area = 0.0;
     size_t n = vertices.size();
+    const double* x = vertices.x.data();
+    const double* y = vertices.y.data();
+    double area = internal::shoelace_simd<kPolygonWidth>(x, y, n - 1);
     
     // Handle case where polygon might not be explicitly closed
-    size_t limit = is_closed() ? n - 1 : n;
-    
-    for (size_t i = 0; i < limit; ++i) {
-        size_t j = (i + 1) % n;
-        area += vertices.x[i] * vertices.y[j];
-        area -= vertices.x[j] * vertices.y[i];
+    if (!is_closed()) {
+        area += x[n - 1] * y[0] - x[0] * y[n - 1];
     }
     
     return area * 0.5;
@@ -44,21 +54,15 @@ bool Polygon::contains(double px, double py) const {
     // Count how many times it crosses polygon edges
     // Odd count = inside, Even count = outside
     
-    bool inside = false;
     size_t n = vertices.size();
-    size_t limit = is_closed() ? n - 1 : n;
+    const double* x = vertices.x.data();
+    const double* y = vertices.y.data();
+    bool inside = internal::crosses_odd_simd<kPolygonWidth>(x, y, n - 1, px, py);
     
-    for (size_t i = 0; i < limit; ++i) {
-        size_t j = (i + 1) % n;
-        
-        double xi = vertices.x[i];
-        double yi = vertices.y[i];
-        double xj = vertices.x[j];
-        double yj = vertices.y[j];
-        
-        // Check if ray crosses this edge
-        if (((yi > py) != (yj > py)) &&
-            (px < (xj - xi) * (py - yi) / (yj - yi) + xi)) {
+    // Closing edge of a polygon that isn't explicitly closed
+    if (!is_closed()) {
+        if (((y[n - 1] > py) != (y[0] > py)) &&
+            (px < (x[0] - x[n - 1]) * (py - y[n - 1]) / (y[0] - y[n - 1]) + x[n - 1])) {
             inside = !inside;
         }
     }
@@ -0,0 +1,231 @@
+#include "geom_simd/clip.h"
+#include "geom_simd/internal/intersect_internal.h"
+#include "geom_simd/internal/simd_kernels.h"
+
+#ifdef HAVE_AVX2
+#include <immintrin.h>
+#include <algorithm>
+
+namespace geom {
+namespace intersect {
+
+void edge_intersect_avx2(
+    double ax1, double ay1, double ax2, double ay2,
+    const PolylineSoA& b_vertices,
+    size_t start_idx,
+    EdgeIntersection results[4]
+) {
+    using V = geom::internal::simd::Vec<double, 4>;
+    
+    // Edge i goes from b_vertices[start_idx+i] to b_vertices[start_idx+i+1]
+    const double* xs = &b_vertices.x[start_idx];
+    const double* ys = &b_vertices.y[start_idx];
+    internal::intersect_block_simd<4>({ax1, ay1}, {ax2, ay2}, V::loadu(xs), V::loadu(ys),
+                                      V::loadu(xs + 1), V::loadu(ys + 1), V::all(), results);
+}
+
+namespace {
+
+// Float version of intersect_block_simd<4>(), 8 float lanes, loading edges
+// from xs/ys itself; lanes at or past count are neither loaded nor reported
+inline void intersect_block_f32(
+    const Point& a1, const Point& a2,
+    const float* xs, const float* ys,
+    size_t count,
+    EdgeIntersection results[8]
+) {
+    // Same unfused math as the AVX-512 float kernel, so the two agree
+    __m256 vax1 = _mm256_set1_ps(static_cast<float>(a1.x));
+    __m256 vay1 = _mm256_set1_ps(static_cast<float>(a1.y));
+    __m256 dx_a = _mm256_sub_ps(_mm256_set1_ps(static_cast<float>(a2.x)), vax1);
+    __m256 dy_a = _mm256_sub_ps(_mm256_set1_ps(static_cast<float>(a2.y)), vay1);
+    
+    // maskload reads lanes whose sign bit is set and zeroes (without
+    // touching memory) the rest
+    __m256i valid = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count)),
+                                       _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    
+    // Load 8 edges from polygon B
+    __m256 bx1 = _mm256_maskload_ps(xs, valid);
+    __m256 by1 = _mm256_maskload_ps(ys, valid);
+    __m256 dx_b = _mm256_sub_ps(_mm256_maskload_ps(xs + 1, valid), bx1);
+    __m256 dy_b = _mm256_sub_ps(_mm256_maskload_ps(ys + 1, valid), by1);
+    
+    __m256 denominator = _mm256_sub_ps(_mm256_mul_ps(dx_a, dy_b), _mm256_mul_ps(dy_a, dx_b));
+    
+    __m256 dx_ab = _mm256_sub_ps(bx1, vax1);
+    __m256 dy_ab = _mm256_sub_ps(by1, vay1);
+    __m256 numerator_t = _mm256_sub_ps(_mm256_mul_ps(dx_ab, dy_b), _mm256_mul_ps(dy_ab, dx_b));
+    __m256 numerator_u = _mm256_sub_ps(_mm256_mul_ps(dx_ab, dy_a), _mm256_mul_ps(dy_ab, dx_a));
+    
+    // Division-free range test, as in intersect_lanes_simd(): numerators
+    // with the denominator's sign flipped out must lie in [0, |denominator|]
+    __m256 zero = _mm256_setzero_ps();
+    __m256 sign_bit = _mm256_set1_ps(-0.0f);
+    __m256 magnitude = _mm256_andnot_ps(sign_bit, denominator);
+    __m256 sign = _mm256_and_ps(sign_bit, denominator);
+    __m256 scaled_t = _mm256_xor_ps(numerator_t, sign);
+    __m256 scaled_u = _mm256_xor_ps(numerator_u, sign);
+    
+    __m256 hit = _mm256_and_ps(_mm256_cmp_ps(scaled_t, zero, _CMP_GE_OQ),
+                               _mm256_cmp_ps(scaled_t, magnitude, _CMP_LE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(scaled_u, zero, _CMP_GE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(scaled_u, magnitude, _CMP_LE_OQ));
+    // Same parallel threshold as the double kernels
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(magnitude, _mm256_set1_ps(1e-10f), _CMP_GE_OQ));
+    
+    int intersects = _mm256_movemask_ps(_mm256_and_ps(hit, _mm256_castsi256_ps(valid)));
+    if (intersects == 0) {
+        std::fill(results, results + 8, EdgeIntersection());
+        return;
+    }
+    
+    __m256 t = _mm256_div_ps(numerator_t, denominator);
+    __m256 u = _mm256_div_ps(numerator_u, denominator);
+    __m256 ix = _mm256_add_ps(vax1, _mm256_mul_ps(t, dx_a));
+    __m256 iy = _mm256_add_ps(vay1, _mm256_mul_ps(t, dy_a));
+    
+    float t_array[8], u_array[8], ix_array[8], iy_array[8];
+    _mm256_storeu_ps(t_array, t);
+    _mm256_storeu_ps(u_array, u);
+    _mm256_storeu_ps(ix_array, ix);
+    _mm256_storeu_ps(iy_array, iy);
+    
+    for (int i = 0; i < 8; ++i) {
+        if (intersects & (1 << i)) {
+            results[i] = EdgeIntersection(true, t_array[i], u_array[i], ix_array[i], iy_array[i]);
+        } else {
+            results[i] = EdgeIntersection();
+        }
+    }
+}
+
+} // anonymous namespace
+
+void edge_intersect_avx2(
+    const Point& a1, const Point& a2,
+    const PolylineSoAf& b_vertices,
+    size_t start_idx,
+    EdgeIntersection results[8]
+) {
+    intersect_block_f32(a1, a2, &b_vertices.x[start_idx], &b_vertices.y[start_idx], 8, results);
+}
+
+void edge_intersect_avx2_i32(
+    const PointI& a1, const PointI& a2,
+    const PolylineSoAi& b_vertices,
+    size_t start_idx,
+    EdgeIntersection results[4]
+) {
+    // Coordinates are widened to int64 lanes and every product is an exact
+    // mul_epi32 (32x32 -> 64 bit), see edge_intersect_scalar_i32()
+    __m256i vax1 = _mm256_set1_epi64x(a1.x);
+    __m256i vay1 = _mm256_set1_epi64x(a1.y);
+    __m256i dx_a = _mm256_set1_epi64x(int64_t{a2.x} - a1.x);
+    __m256i dy_a = _mm256_set1_epi64x(int64_t{a2.y} - a1.y);
+    
+    auto load4 = [](const int32_t* p) {
+        return _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    };
+    
+    // Load 4 edges from polygon B
+    __m256i bx1 = load4(&b_vertices.x[start_idx]);
+    __m256i by1 = load4(&b_vertices.y[start_idx]);
+    __m256i dx_b = _mm256_sub_epi64(load4(&b_vertices.x[start_idx + 1]), bx1);
+    __m256i dy_b = _mm256_sub_epi64(load4(&b_vertices.y[start_idx + 1]), by1);
+    __m256i dx_ab = _mm256_sub_epi64(bx1, vax1);
+    __m256i dy_ab = _mm256_sub_epi64(by1, vay1);
+    
+    __m256i denominator = _mm256_sub_epi64(_mm256_mul_epi32(dx_a, dy_b), _mm256_mul_epi32(dy_a, dx_b));
+    __m256i numerator_t = _mm256_sub_epi64(_mm256_mul_epi32(dx_ab, dy_b), _mm256_mul_epi32(dy_ab, dx_b));
+    __m256i numerator_u = _mm256_sub_epi64(_mm256_mul_epi32(dx_ab, dy_a), _mm256_mul_epi32(dy_ab, dx_a));
+    
+    // Make the denominator positive, then t and u are in [0, 1] iff their
+    // numerators are in [0, denominator]. No division, no epsilon.
+    __m256i zero = _mm256_setzero_si256();
+    __m256i negative = _mm256_cmpgt_epi64(zero, denominator);
+    denominator = _mm256_blendv_epi8(denominator, _mm256_sub_epi64(zero, denominator), negative);
+    numerator_t = _mm256_blendv_epi8(numerator_t, _mm256_sub_epi64(zero, numerator_t), negative);
+    numerator_u = _mm256_blendv_epi8(numerator_u, _mm256_sub_epi64(zero, numerator_u), negative);
+    
+    // AVX2 only has == and >, so collect the failing lanes instead
+    __m256i misses = _mm256_cmpeq_epi64(denominator, zero);
+    misses = _mm256_or_si256(misses, _mm256_cmpgt_epi64(zero, numerator_t));
+    misses = _mm256_or_si256(misses, _mm256_cmpgt_epi64(numerator_t, denominator));
+    misses = _mm256_or_si256(misses, _mm256_cmpgt_epi64(zero, numerator_u));
+    misses = _mm256_or_si256(misses, _mm256_cmpgt_epi64(numerator_u, denominator));
+    int intersects = ~_mm256_movemask_pd(_mm256_castsi256_pd(misses)) & 0xF;
+    
+    alignas(32) int64_t den_array[4], t_array[4], u_array[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(den_array), denominator);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(t_array), numerator_t);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(u_array), numerator_u);
+    
+    // Hits are rare, so t, u and the point are finished in scalar
+    for (int i = 0; i < 4; ++i) {
+        if (intersects & (1 << i)) {
+            results[i] = internal::fixed_point_hit(a1, a2, t_array[i], u_array[i], den_array[i]);
+        } else {
+            results[i] = EdgeIntersection();
+        }
+    }
+}
+
+namespace internal {
+
+void edge_range_avx2(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                     size_t start_idx, size_t count, EdgeIntersection* results) {
+    edge_range_simd<4>(a1, a2, &b_vertices.x[start_idx], &b_vertices.y[start_idx], count, results);
+}
+
+size_t edge_batch_avx2(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                       size_t start_idx, size_t count, double* t, double* u,
+                       double* x, double* y, size_t* edge) {
+    return edge_batch_simd<4>(a1, a2, &b_vertices.x[start_idx], &b_vertices.y[start_idx],
+                              start_idx, count, t, u, x, y, edge);
+}
+
+size_t edge_tile_avx2(const PolylineSoA& a, size_t a_first, size_t a_count,
+                      const PolylineSoA& b, size_t b_first, size_t b_count,
+                      EdgeHit* hits, size_t capacity) {
+    return edge_tile_simd<4, 2>(a, a_first, a_count, b, b_first, b_count, hits, capacity);
+}
+
+void edge_range_avx2_f32(const Point& a1, const Point& a2, const PolylineSoAf& b_vertices,
+                         size_t start_idx, size_t count, EdgeIntersection* results) {
+    const float* xs = &b_vertices.x[start_idx];
+    const float* ys = &b_vertices.y[start_idx];
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        intersect_block_f32(a1, a2, xs + i, ys + i, 8, &results[i]);
+    }
+    // Masked tail block, so the float result doesn't depend on where an
+    // edge falls in the range
+    if (i < count) {
+        EdgeIntersection tail[8];
+        intersect_block_f32(a1, a2, xs + i, ys + i, count - i, tail);
+        std::copy(tail, tail + (count - i), &results[i]);
+    }
+}
+
+void edge_range_avx2_i32(const PointI& a1, const PointI& a2, const PolylineSoAi& b_vertices,
+                         size_t start_idx, size_t count, EdgeIntersection* results) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        edge_intersect_avx2_i32(a1, a2, b_vertices, start_idx + i, &results[i]);
+    }
+    // Every i32 kernel is exact, so the last few edges can go scalar
+    for (; i < count; ++i) {
+        size_t e = start_idx + i;
+        results[i] = edge_intersect_scalar_i32(a1, a2,
+                                               {b_vertices.x[e], b_vertices.y[e]},
+                                               {b_vertices.x[e + 1], b_vertices.y[e + 1]});
+    }
+}
+
+} // namespace internal
+
+} // namespace intersect
+} // namespace geom
+
+#endif // HAVE_AVX2
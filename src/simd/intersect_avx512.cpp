@@ -1,7 +1,10 @@
 #include "geom_simd/clip.h"
+#include "geom_simd/internal/intersect_internal.h"
+#include "geom_simd/internal/simd_kernels.h"
 
 #ifdef HAVE_AVX512
 #include <immintrin.h>
+#include <algorithm>
 #include <cmath>
 
 namespace geom {
@@ -23,16 +26,6 @@ void edge_intersect_avx512(
      * We'll broadcast edge A's coordinates and load 8 edges from B in parallel.
      */
     
-    // Broadcast edge A's coordinates to all lanes
-    __m512d vax1 = _mm512_set1_pd(a1.x);
-    __m512d vay1 = _mm512_set1_pd(a1.y);
-    __m512d vax2 = _mm512_set1_pd(a2.x);
-    __m512d vay2 = _mm512_set1_pd(a2.y);
-    
-    // Direction vector for edge A: (dx_a, dy_a)
-    __m512d dx_a = _mm512_sub_pd(vax2, vax1);
-    __m512d dy_a = _mm512_sub_pd(vay2, vay1);
-    
     // Load 8 edges from polygon B
     // Edge i goes from b_vertices[start_idx+i] to b_vertices[start_idx+i+1]
     __m512d bx1 = _mm512_loadu_pd(&b_vertices.x[start_idx]);
@@ -40,74 +33,237 @@ void edge_intersect_avx512(
     __m512d bx2 = _mm512_loadu_pd(&b_vertices.x[start_idx + 1]);
     __m512d by2 = _mm512_loadu_pd(&b_vertices.y[start_idx + 1]);
     
-    // Direction vectors for 8 edges in B: (dx_b, dy_b)
-    __m512d dx_b = _mm512_sub_pd(bx2, bx1);
-    __m512d dy_b = _mm512_sub_pd(by2, by1);
+    internal::intersect_block_simd<8>(a1, a2, bx1, by1, bx2, by2, 0xFF, results);
+}
+
+void edge_intersect_avx512_masked(
+    const Point& a1, const Point& a2,
+    const PolylineSoA& b_vertices,
+    size_t start_idx,
+    size_t count,
+    EdgeIntersection results[8]
+) {
+    // Lanes at or past count are never loaded, so the last vertex read is
+    // b_vertices[start_idx + count]
+    __mmask8 load = count >= 8 ? __mmask8(0xFF) : static_cast<__mmask8>((1u << count) - 1);
+    __m512d bx1 = _mm512_maskz_loadu_pd(load, &b_vertices.x[start_idx]);
+    __m512d by1 = _mm512_maskz_loadu_pd(load, &b_vertices.y[start_idx]);
+    __m512d bx2 = _mm512_maskz_loadu_pd(load, &b_vertices.x[start_idx + 1]);
+    __m512d by2 = _mm512_maskz_loadu_pd(load, &b_vertices.y[start_idx + 1]);
+    
+    internal::intersect_block_simd<8>(a1, a2, bx1, by1, bx2, by2, load, results);
+}
+
+namespace {
+
+// Float version of intersect_block_simd<8>(), loading edges from xs/ys
+// itself; lanes outside valid are neither loaded nor reported
+inline void intersect_block_f32(
+    const Point& a1, const Point& a2,
+    const float* xs, const float* ys,
+    __mmask16 valid,
+    EdgeIntersection results[16]
+) {
+    // Same math as the double kernel, unfused, 16 float lanes per vector
+    __m512 vax1 = _mm512_set1_ps(static_cast<float>(a1.x));
+    __m512 vay1 = _mm512_set1_ps(static_cast<float>(a1.y));
+    __m512 dx_a = _mm512_sub_ps(_mm512_set1_ps(static_cast<float>(a2.x)), vax1);
+    __m512 dy_a = _mm512_sub_ps(_mm512_set1_ps(static_cast<float>(a2.y)), vay1);
     
-    // Calculate denominator: (A2 - A1) × (B2 - B1) = dx_a * dy_b - dy_a * dx_b
-    __m512d denominator = _mm512_fmsub_pd(dx_a, dy_b, _mm512_mul_pd(dy_a, dx_b));
+    // Load 16 edges from polygon B
+    __m512 bx1 = _mm512_maskz_loadu_ps(valid, xs);
+    __m512 by1 = _mm512_maskz_loadu_ps(valid, ys);
+    __m512 dx_b = _mm512_sub_ps(_mm512_maskz_loadu_ps(valid, xs + 1), bx1);
+    __m512 dy_b = _mm512_sub_ps(_mm512_maskz_loadu_ps(valid, ys + 1), by1);
     
-    // Vector from A1 to B1 for each of the 8 edges
-    __m512d dx_ab = _mm512_sub_pd(bx1, vax1);
-    __m512d dy_ab = _mm512_sub_pd(by1, vay1);
+    __m512 denominator = _mm512_sub_ps(_mm512_mul_ps(dx_a, dy_b), _mm512_mul_ps(dy_a, dx_b));
     
-    // Calculate numerators for t and u
-    // numerator_t = (B1 - A1) × (B2 - B1) = dx_ab * dy_b - dy_ab * dx_b
-    __m512d numerator_t = _mm512_fmsub_pd(dx_ab, dy_b, _mm512_mul_pd(dy_ab, dx_b));
+    __m512 dx_ab = _mm512_sub_ps(bx1, vax1);
+    __m512 dy_ab = _mm512_sub_ps(by1, vay1);
+    __m512 numerator_t = _mm512_sub_ps(_mm512_mul_ps(dx_ab, dy_b), _mm512_mul_ps(dy_ab, dx_b));
+    __m512 numerator_u = _mm512_sub_ps(_mm512_mul_ps(dx_ab, dy_a), _mm512_mul_ps(dy_ab, dx_a));
     
-    // numerator_u = (B1 - A1) × (A2 - A1) = dx_ab * dy_a - dy_ab * dx_a
-    __m512d numerator_u = _mm512_fmsub_pd(dx_ab, dy_a, _mm512_mul_pd(dy_ab, dx_a));
+    // Division-free range test, as in intersect_lanes_simd(): numerators
+    // with the denominator's sign flipped out must lie in [0, |denominator|]
+    __m512 zero = _mm512_setzero_ps();
+    __m512 magnitude = _mm512_abs_ps(denominator);
+    __m512i sign = _mm512_and_si512(_mm512_castps_si512(denominator), _mm512_set1_epi32(INT32_MIN));
+    __m512 scaled_t = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(numerator_t), sign));
+    __m512 scaled_u = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(numerator_u), sign));
     
-    // Calculate t and u
-    __m512d t = _mm512_div_pd(numerator_t, denominator);
-    __m512d u = _mm512_div_pd(numerator_u, denominator);
+    __mmask16 t_valid = _mm512_cmp_ps_mask(scaled_t, zero, _CMP_GE_OQ) & 
+                        _mm512_cmp_ps_mask(scaled_t, magnitude, _CMP_LE_OQ);
+    __mmask16 u_valid = _mm512_cmp_ps_mask(scaled_u, zero, _CMP_GE_OQ) & 
+                        _mm512_cmp_ps_mask(scaled_u, magnitude, _CMP_LE_OQ);
+    
+    // Same parallel threshold as the double kernels
+    __mmask16 not_parallel = _mm512_cmp_ps_mask(magnitude, _mm512_set1_ps(1e-10f), _CMP_GE_OQ);
+    
+    __mmask16 intersects = t_valid & u_valid & not_parallel & valid;
+    if (intersects == 0) {
+        std::fill(results, results + 16, EdgeIntersection());
+        return;
+    }
+    
+    __m512 t = _mm512_div_ps(numerator_t, denominator);
+    __m512 u = _mm512_div_ps(numerator_u, denominator);
+    __m512 ix = _mm512_add_ps(vax1, _mm512_mul_ps(t, dx_a));
+    __m512 iy = _mm512_add_ps(vay1, _mm512_mul_ps(t, dy_a));
+    
+    float t_array[16], u_array[16], ix_array[16], iy_array[16];
+    _mm512_storeu_ps(t_array, t);
+    _mm512_storeu_ps(u_array, u);
+    _mm512_storeu_ps(ix_array, ix);
+    _mm512_storeu_ps(iy_array, iy);
+    
+    for (int i = 0; i < 16; ++i) {
+        if (intersects & (1 << i)) {
+            results[i] = EdgeIntersection(true, t_array[i], u_array[i], ix_array[i], iy_array[i]);
+        } else {
+            results[i] = EdgeIntersection();
+        }
+    }
+}
+
+// Integer version of intersect_block_simd<8>(), loading edges from xs/ys itself;
+// lanes outside valid are neither loaded nor reported
+inline void intersect_block_i32(
+    const PointI& a1, const PointI& a2,
+    const int32_t* xs, const int32_t* ys,
+    __mmask8 valid,
+    EdgeIntersection results[8]
+) {
+    // Coordinates are widened to int64 lanes and every product is an exact
+    // mul_epi32 (32x32 -> 64 bit)
+    __m512i vax1 = _mm512_set1_epi64(a1.x);
+    __m512i vay1 = _mm512_set1_epi64(a1.y);
+    __m512i dx_a = _mm512_set1_epi64(int64_t{a2.x} - a1.x);
+    __m512i dy_a = _mm512_set1_epi64(int64_t{a2.y} - a1.y);
     
-    // Check if t and u are in valid range [0, 1]
-    __m512d zero = _mm512_setzero_pd();
-    __m512d one = _mm512_set1_pd(1.0);
+    // 256-bit masked loads need AVX512VL, so load the low half of a zmm
+    // (extracted with a mask, GCC 12 warns on the cast's undefined upper half)
+    auto load8 = [valid](const int32_t* p) {
+        __m256i low = _mm512_maskz_extracti64x4_epi64(0xF, _mm512_maskz_loadu_epi32(valid, p), 0);
+        return _mm512_maskz_cvtepi32_epi64(0xFF, low);
+    };
     
-    __mmask8 t_valid = _mm512_cmp_pd_mask(t, zero, _CMP_GE_OQ) & 
-                       _mm512_cmp_pd_mask(t, one, _CMP_LE_OQ);
-    __mmask8 u_valid = _mm512_cmp_pd_mask(u, zero, _CMP_GE_OQ) & 
-                       _mm512_cmp_pd_mask(u, one, _CMP_LE_OQ);
+    // Load 8 edges from polygon B
+    __m512i bx1 = load8(xs);
+    __m512i by1 = load8(ys);
+    __m512i dx_b = _mm512_sub_epi64(load8(xs + 1), bx1);
+    __m512i dy_b = _mm512_sub_epi64(load8(ys + 1), by1);
+    __m512i dx_ab = _mm512_sub_epi64(bx1, vax1);
+    __m512i dy_ab = _mm512_sub_epi64(by1, vay1);
     
-    // Check for non-zero denominator (not parallel)
-    __m512d epsilon = _mm512_set1_pd(1e-10);
-    __m512d abs_denom = _mm512_abs_pd(denominator);
-    __mmask8 not_parallel = _mm512_cmp_pd_mask(abs_denom, epsilon, _CMP_GT_OQ);
+    __m512i denominator = _mm512_sub_epi64(_mm512_maskz_mul_epi32(0xFF, dx_a, dy_b), _mm512_maskz_mul_epi32(0xFF, dy_a, dx_b));
+    __m512i numerator_t = _mm512_sub_epi64(_mm512_maskz_mul_epi32(0xFF, dx_ab, dy_b), _mm512_maskz_mul_epi32(0xFF, dy_ab, dx_b));
+    __m512i numerator_u = _mm512_sub_epi64(_mm512_maskz_mul_epi32(0xFF, dx_ab, dy_a), _mm512_maskz_mul_epi32(0xFF, dy_ab, dx_a));
     
-    // Intersection valid if all conditions met
-    __mmask8 intersects = t_valid & u_valid & not_parallel;
+    // Make the denominator positive, then t and u are in [0, 1] iff their
+    // numerators are in [0, denominator]. No division, no epsilon.
+    __m512i zero = _mm512_setzero_si512();
+    __mmask8 negative = _mm512_cmplt_epi64_mask(denominator, zero);
+    denominator = _mm512_mask_sub_epi64(denominator, negative, zero, denominator);
+    numerator_t = _mm512_mask_sub_epi64(numerator_t, negative, zero, numerator_t);
+    numerator_u = _mm512_mask_sub_epi64(numerator_u, negative, zero, numerator_u);
     
-    // Calculate intersection points for all 8 edges
-    // ix = ax1 + t * dx_a
-    // iy = ay1 + t * dy_a
-    __m512d ix = _mm512_fmadd_pd(t, dx_a, vax1);
-    __m512d iy = _mm512_fmadd_pd(t, dy_a, vay1);
+    __mmask8 intersects = valid &
+                          _mm512_cmpneq_epi64_mask(denominator, zero) &
+                          _mm512_cmpge_epi64_mask(numerator_t, zero) &
+                          _mm512_cmple_epi64_mask(numerator_t, denominator) &
+                          _mm512_cmpge_epi64_mask(numerator_u, zero) &
+                          _mm512_cmple_epi64_mask(numerator_u, denominator);
     
-    // Extract results to scalar array
-    double t_array[8], u_array[8], ix_array[8], iy_array[8];
-    _mm512_storeu_pd(t_array, t);
-    _mm512_storeu_pd(u_array, u);
-    _mm512_storeu_pd(ix_array, ix);
-    _mm512_storeu_pd(iy_array, iy);
+    alignas(64) long long den_array[8], t_array[8], u_array[8];
+    _mm512_store_epi64(den_array, denominator);
+    _mm512_store_epi64(t_array, numerator_t);
+    _mm512_store_epi64(u_array, numerator_u);
     
-    // Fill results array
+    // Hits are rare, so t, u and the point are finished in scalar
     for (int i = 0; i < 8; ++i) {
         if (intersects & (1 << i)) {
-            results[i] = EdgeIntersection(
-                true,
-                t_array[i],
-                u_array[i],
-                ix_array[i],
-                iy_array[i]
-            );
+            results[i] = internal::fixed_point_hit(a1, a2, t_array[i], u_array[i], den_array[i]);
         } else {
-            results[i] = EdgeIntersection();  // No intersection
+            results[i] = EdgeIntersection();
         }
     }
 }
 
+// Range driver for the float and integer kernels: full blocks straight into
+// results, then one masked block into a local buffer
+template <size_t Width, typename Mask, typename Block>
+void edge_range(size_t count, EdgeIntersection* results, Block block) {
+    size_t i = 0;
+    for (; i + Width <= count; i += Width) {
+        block(i, static_cast<Mask>(~Mask{0}), &results[i]);
+    }
+    if (i < count) {
+        EdgeIntersection tail[Width];
+        block(i, static_cast<Mask>((1u << (count - i)) - 1), tail);
+        std::copy(tail, tail + (count - i), &results[i]);
+    }
+}
+
+} // anonymous namespace
+
+void edge_intersect_avx512(
+    const Point& a1, const Point& a2,
+    const PolylineSoAf& b_vertices,
+    size_t start_idx,
+    EdgeIntersection results[16]
+) {
+    intersect_block_f32(a1, a2, &b_vertices.x[start_idx], &b_vertices.y[start_idx], 0xFFFF, results);
+}
+
+void edge_intersect_avx512_i32(
+    const PointI& a1, const PointI& a2,
+    const PolylineSoAi& b_vertices,
+    size_t start_idx,
+    EdgeIntersection results[8]
+) {
+    intersect_block_i32(a1, a2, &b_vertices.x[start_idx], &b_vertices.y[start_idx], 0xFF, results);
+}
+
+namespace internal {
+
+void edge_range_avx512(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                       size_t start_idx, size_t count, EdgeIntersection* results) {
+    edge_range_simd<8>(a1, a2, &b_vertices.x[start_idx], &b_vertices.y[start_idx], count, results);
+}
+
+size_t edge_batch_avx512(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                         size_t start_idx, size_t count, double* t, double* u,
+                         double* x, double* y, size_t* edge) {
+    return edge_batch_simd<8>(a1, a2, &b_vertices.x[start_idx], &b_vertices.y[start_idx],
+                              start_idx, count, t, u, x, y, edge);
+}
+
+size_t edge_tile_avx512(const PolylineSoA& a, size_t a_first, size_t a_count,
+                        const PolylineSoA& b, size_t b_first, size_t b_count,
+                        EdgeHit* hits, size_t capacity) {
+    return edge_tile_simd<8, 4>(a, a_first, a_count, b, b_first, b_count, hits, capacity);
+}
+
+void edge_range_avx512_f32(const Point& a1, const Point& a2, const PolylineSoAf& b_vertices,
+                           size_t start_idx, size_t count, EdgeIntersection* results) {
+    const float* xs = &b_vertices.x[start_idx];
+    const float* ys = &b_vertices.y[start_idx];
+    edge_range<16, __mmask16>(count, results, [&](size_t i, __mmask16 valid, EdgeIntersection* out) {
+        intersect_block_f32(a1, a2, xs + i, ys + i, valid, out);
+    });
+}
+
+void edge_range_avx512_i32(const PointI& a1, const PointI& a2, const PolylineSoAi& b_vertices,
+                           size_t start_idx, size_t count, EdgeIntersection* results) {
+    const int32_t* xs = &b_vertices.x[start_idx];
+    const int32_t* ys = &b_vertices.y[start_idx];
+    edge_range<8, __mmask8>(count, results, [&](size_t i, __mmask8 valid, EdgeIntersection* out) {
+        intersect_block_i32(a1, a2, xs + i, ys + i, valid, out);
+    });
+}
+
+} // namespace internal
+
 } // namespace intersect
 } // namespace geom
 
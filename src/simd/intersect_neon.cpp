@@ -0,0 +1,23 @@
+#include "geom_simd/clip.h"
+#include "geom_simd/internal/intersect_internal.h"
+
+#ifdef HAVE_NEON
+
+namespace geom {
+namespace intersect {
+
+void edge_intersect_neon(
+    double ax1, double ay1, double ax2, double ay2,
+    const PolylineSoA& b_vertices,
+    size_t start_idx,
+    EdgeIntersection results[2]
+) {
+    // No NEON kernel yet; like simplify_neon(), run the scalar one so
+    // NEON builds link and match edge_intersect_scalar() exactly
+    internal::edge_range_scalar({ax1, ay1}, {ax2, ay2}, b_vertices, start_idx, 2, results);
+}
+
+} // namespace intersect
+} // namespace geom
+
+#endif // HAVE_NEON
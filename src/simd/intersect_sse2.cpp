@@ -0,0 +1,45 @@
+#include "geom_simd/clip.h"
+#include "geom_simd/internal/intersect_internal.h"
+#include "geom_simd/internal/simd_kernels.h"
+
+#ifdef HAVE_SSE2
+
+namespace geom {
+namespace intersect {
+
+void edge_intersect_sse2(
+    const Point& a1, const Point& a2,
+    const PolylineSoA& b_vertices,
+    size_t start_idx,
+    EdgeIntersection results[2]
+) {
+    internal::edge_range_simd<2>(a1, a2, &b_vertices.x[start_idx], &b_vertices.y[start_idx],
+                                 2, results);
+}
+
+namespace internal {
+
+void edge_range_sse2(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                     size_t start_idx, size_t count, EdgeIntersection* results) {
+    edge_range_simd<2>(a1, a2, &b_vertices.x[start_idx], &b_vertices.y[start_idx], count, results);
+}
+
+size_t edge_batch_sse2(const Point& a1, const Point& a2, const PolylineSoA& b_vertices,
+                       size_t start_idx, size_t count, double* t, double* u,
+                       double* x, double* y, size_t* edge) {
+    return edge_batch_simd<2>(a1, a2, &b_vertices.x[start_idx], &b_vertices.y[start_idx],
+                              start_idx, count, t, u, x, y, edge);
+}
+
+size_t edge_tile_sse2(const PolylineSoA& a, size_t a_first, size_t a_count,
+                      const PolylineSoA& b, size_t b_first, size_t b_count,
+                      EdgeHit* hits, size_t capacity) {
+    return edge_tile_simd<2, 1>(a, a_first, a_count, b, b_first, b_count, hits, capacity);
+}
+
+} // namespace internal
+
+} // namespace intersect
+} // namespace geom
+
+#endif // HAVE_SSE2
@@ -1,3 +1,4 @@
+#include "geom_simd/internal/simd_kernels.h"
 #include "geom_simd/internal/simplify_internal.h"
 #include <immintrin.h>
 
@@ -6,36 +7,220 @@ namespace internal {
 
 #ifdef HAVE_AVX2
 
-PolylineSoA simplify_avx2(const PolylineSoA& input, double tolerance) {
-    // TODO: Implement AVX2 version
-    // 
-    // Key optimizations:
-    // 1. Process 4 points at once using __m256d (4x doubles in 256-bit register)
-    // 2. Vectorize the perpendicular distance calculation
-    // 3. Use horizontal operations to find max distance efficiently
-    //
-    // Algorithm outline:
-    // - Still use recursive structure (like scalar version)
-    // - But in the inner loop that finds max distance point:
-    //   * Load 4 points' coordinates at once
-    //   * Calculate distances for all 4 simultaneously
-    //   * Track maximum across vectors
-    //   * Handle remainder points with scalar code
-    //
-    // Useful intrinsics:
-    // - _mm256_load_pd / _mm256_loadu_pd: Load 4 doubles
-    // - _mm256_mul_pd: Multiply 4 doubles
-    // - _mm256_add_pd / _mm256_sub_pd: Add/subtract
-    // - _mm256_fmadd_pd: Fused multiply-add (use -mfma flag)
-    // - _mm256_max_pd: Element-wise maximum
-    // - _mm256_cmp_pd: Compare
-    //
-    // References:
-    // - Intel Intrinsics Guide: https://www.intel.com/content/www/us/en/docs/intrinsics-guide/
-    // - AVX2 tutorial: https://www.codeproject.com/Articles/874396/Crunching-Numbers-with-AVX-and-AVX
-    
-    // For now, fall back to scalar implementation
-    return simplify_scalar(input, tolerance);
+/**
+ * Max-distance scan in AVX2, 4 points per iteration
+ *
+ * @param points Input points
+ * @param start Start index (inclusive)
+ * @param end End index (inclusive)
+ * @return Farthest interior point and its squared distance
+ */
+FarthestPoint find_farthest_avx2(const PolylineSoA& points,
+                                 size_t start,
+                                 size_t end) {
+    return find_farthest_simd<4>(points, start, end);
+}
+
+void simplify_avx2(const PolylineSoA& input, double tolerance, SimplifyScratch& scratch) {
+    simplify_serial(input, tolerance, scratch, find_farthest_avx2);
+}
+
+/**
+ * Single-precision max-distance scan, 8 points per iteration. Indices are
+ * carried as int32 offsets from start.
+ */
+FarthestPoint find_farthest_avx2_f32(const PolylineSoAf& points,
+                                     size_t start,
+                                     size_t end) {
+    float px1 = points.x[start];
+    float py1 = points.y[start];
+    float seg_dx = points.x[end] - px1;
+    float seg_dy = points.y[end] - py1;
+    float seg_mag_sq = seg_dx * seg_dx + seg_dy * seg_dy;
+    const bool degenerate = seg_mag_sq < 1e-10f;
+
+    __m256 x1 = _mm256_set1_ps(px1);
+    __m256 y1 = _mm256_set1_ps(py1);
+    __m256 dx = _mm256_set1_ps(seg_dx);
+    __m256 dy = _mm256_set1_ps(seg_dy);
+
+    // mul/sub rather than fmsub so keys round like find_farthest_scalar_f32()
+    auto distance_key = [&](__m256 px, __m256 py) {
+        __m256 dpx = _mm256_sub_ps(px, x1);
+        __m256 dpy = _mm256_sub_ps(py, y1);
+        if (degenerate) {
+            return _mm256_add_ps(_mm256_mul_ps(dpx, dpx), _mm256_mul_ps(dpy, dpy));
+        }
+        __m256 cross = _mm256_sub_ps(_mm256_mul_ps(dpx, dy), _mm256_mul_ps(dpy, dx));
+        return _mm256_mul_ps(cross, cross);
+    };
+
+    // Aligned blocks of 8 over the padded storage, same scheme as
+    // find_farthest_avx2(); lanes outside (start, end) are masked out of the
+    // compare. Offsets are relative to start, so head lanes go negative.
+    const float* xs = points.x.data();
+    const float* ys = points.y.data();
+    size_t first = start + 1;
+    if (first >= end) {
+        return {0.0, start};
+    }
+    size_t i = first & ~size_t{7};
+
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256 vmax = _mm256_setzero_ps();
+    __m256i vidx = _mm256_setzero_si256();
+    __m256i cur_idx = _mm256_sub_epi32(lane, _mm256_set1_epi32(static_cast<int>(start - i)));
+    const __m256i eight = _mm256_set1_epi32(8);
+
+    auto lanes_below = [&](size_t count) {
+        int clamped = count < 8 ? static_cast<int>(count) : 8;
+        return _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(clamped), lane));
+    };
+
+    auto step = [&](__m256 key, __m256 lanes) {
+        // strict gt keeps the first occurrence per lane, like the scalar scan
+        __m256 gt = _mm256_and_ps(_mm256_cmp_ps(key, vmax, _CMP_GT_OQ), lanes);
+        vmax = _mm256_blendv_ps(vmax, key, gt);
+        vidx = _mm256_blendv_epi8(vidx, cur_idx, _mm256_castps_si256(gt));
+        cur_idx = _mm256_add_epi32(cur_idx, eight);
+    };
+
+    // Head block, which may also be the tail
+    step(distance_key(_mm256_load_ps(&xs[i]), _mm256_load_ps(&ys[i])),
+         _mm256_andnot_ps(lanes_below(first - i), lanes_below(end - i)));
+    i += 8;
+
+    const __m256 all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (; i + 8 <= end; i += 8) {
+        step(distance_key(_mm256_load_ps(&xs[i]), _mm256_load_ps(&ys[i])), all);
+    }
+
+    // Tail block reads into the padding
+    if (i < end) {
+        step(distance_key(_mm256_load_ps(&xs[i]), _mm256_load_ps(&ys[i])), lanes_below(end - i));
+    }
+
+    alignas(32) float maxes[8];
+    alignas(32) int32_t offsets[8];
+    _mm256_store_ps(maxes, vmax);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(offsets), vidx);
+
+    float max_key = 0.0f;
+    int32_t max_offset = 0;
+    for (int j = 0; j < 8; ++j) {
+        if (maxes[j] > max_key || (maxes[j] == max_key && offsets[j] < max_offset)) {
+            max_key = maxes[j];
+            max_offset = offsets[j];
+        }
+    }
+
+    float max_dist_sq = degenerate ? max_key : max_key / seg_mag_sq;
+    return {max_dist_sq, start + static_cast<size_t>(max_offset)};
+}
+
+/**
+ * Fixed-point max-distance scan, 4 points per iteration. Coordinates are
+ * widened to int64 lanes and multiplied with mul_epi32 (32x32 -> 64 bit).
+ */
+FarthestPoint find_farthest_avx2_i32(const PolylineSoAi& points,
+                                     size_t start,
+                                     size_t end) {
+    int64_t px1 = points.x[start];
+    int64_t py1 = points.y[start];
+    int64_t seg_dx = points.x[end] - px1;
+    int64_t seg_dy = points.y[end] - py1;
+    int64_t chord_sq = seg_dx * seg_dx + seg_dy * seg_dy;
+    const bool degenerate = chord_sq == 0;
+
+    __m256i x1 = _mm256_set1_epi64x(px1);
+    __m256i y1 = _mm256_set1_epi64x(py1);
+    __m256i dx = _mm256_set1_epi64x(seg_dx);
+    __m256i dy = _mm256_set1_epi64x(seg_dy);
+    const __m256i zero = _mm256_setzero_si256();
+
+    auto distance_key = [&](__m128i px, __m128i py) {
+        __m256i dpx = _mm256_sub_epi64(_mm256_cvtepi32_epi64(px), x1);
+        __m256i dpy = _mm256_sub_epi64(_mm256_cvtepi32_epi64(py), y1);
+        if (degenerate) {
+            return _mm256_add_epi64(_mm256_mul_epi32(dpx, dpx), _mm256_mul_epi32(dpy, dpy));
+        }
+        __m256i cross = _mm256_sub_epi64(_mm256_mul_epi32(dpx, dy), _mm256_mul_epi32(dpy, dx));
+        // No abs_epi64 before AVX-512: flip and add one where negative
+        __m256i sign = _mm256_cmpgt_epi64(zero, cross);
+        return _mm256_sub_epi64(_mm256_xor_si256(cross, sign), sign);
+    };
+
+    __m256i vmax = zero;
+    __m256i vidx = _mm256_set1_epi64x(static_cast<long long>(start));
+    size_t i = start + 1;
+    __m256i cur_idx = _mm256_add_epi64(_mm256_setr_epi64x(0, 1, 2, 3),
+                                       _mm256_set1_epi64x(static_cast<long long>(i)));
+    const __m256i four = _mm256_set1_epi64x(4);
+
+    for (; i + 3 < end; i += 4) {
+        __m256i key = distance_key(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&points.x[i])),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(&points.y[i])));
+
+        // strict gt keeps the first occurrence per lane, like the scalar scan
+        __m256i gt = _mm256_cmpgt_epi64(key, vmax);
+        vmax = _mm256_blendv_epi8(vmax, key, gt);
+        vidx = _mm256_blendv_epi8(vidx, cur_idx, gt);
+        cur_idx = _mm256_add_epi64(cur_idx, four);
+    }
+
+    // Masked tail: masked-off lanes read as zero and are dropped from the compare
+    if (i < end) {
+        __m128i load_mask = _mm_cmpgt_epi32(_mm_set1_epi32(static_cast<int>(end - i)),
+                                            _mm_setr_epi32(0, 1, 2, 3));
+        __m256i key = distance_key(_mm_maskload_epi32(&points.x[i], load_mask),
+                                   _mm_maskload_epi32(&points.y[i], load_mask));
+
+        __m256i gt = _mm256_and_si256(_mm256_cmpgt_epi64(key, vmax),
+                                      _mm256_cvtepi32_epi64(load_mask));
+        vmax = _mm256_blendv_epi8(vmax, key, gt);
+        vidx = _mm256_blendv_epi8(vidx, cur_idx, gt);
+    }
+
+    alignas(32) int64_t maxes[4];
+    alignas(32) int64_t idxs[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(maxes), vmax);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(idxs), vidx);
+
+    int64_t max_key = 0;
+    size_t max_idx = start;
+    for (int j = 0; j < 4; ++j) {
+        size_t idx = static_cast<size_t>(idxs[j]);
+        if (maxes[j] > max_key || (maxes[j] == max_key && idx < max_idx)) {
+            max_key = maxes[j];
+            max_idx = idx;
+        }
+    }
+
+    return {fixed_point_dist_sq(max_key, chord_sq), max_idx};
+}
+
+void sweep_level_avx2(const PolylineSoA& points, const Segment* segs, size_t count,
+                      FarthestPoint* out, const PackedLanes&) {
+    sweep_level_with(points, segs, count, out, find_farthest_avx2);
+}
+
+size_t filter_significant_avx2(const double* x, const double* y, const double* significance,
+                               size_t n, double threshold, double* out_x, double* out_y) {
+    return filter_significant_simd<4>(x, y, significance, n, threshold, out_x, out_y);
+}
+
+void triangle_areas_avx2(const double* x, const double* y, size_t n, double* areas) {
+    triangle_areas_simd<4>(x, y, n, areas);
+}
+
+size_t find_exit_avx2(const double* x, const double* y, size_t n,
+                      double kx, double ky, double dx, double dy, double limit) {
+    return find_exit_simd<4>(x, y, n, kx, ky, dx, dy, limit);
+}
+
+size_t radial_filter_avx2(const double* x, const double* y, size_t n,
+                          double tolerance_sq, double* out_x, double* out_y) {
+    return radial_filter_simd<4>(x, y, n, tolerance_sq, out_x, out_y);
 }
 
 #endif // HAVE_AVX2
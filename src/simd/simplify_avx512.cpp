@@ -1,5 +1,7 @@
+#include "geom_simd/internal/simd_kernels.h"
 #include "geom_simd/internal/simplify_internal.h"
 #include <immintrin.h>
+#include <limits>
 
 namespace geom {
 namespace internal {
@@ -7,127 +9,419 @@ namespace internal {
 #ifdef HAVE_AVX512
 
 /**
- * Recursive Douglas-Peucker implementation in AVX-512
+ * Max-distance scan in AVX-512, 8 points per iteration
  * 
  * @param points Input points
  * @param start Start index (inclusive)
  * @param end End index (inclusive)
- * @param tolerance_sq Squared tolerance threshold
- * @param keep Bitmask of which points to keep
+ * @return Farthest interior point and its squared distance
  */
-void rdpr_avx512(const PolylineSoA& points,
-                               size_t start,
-                               size_t end,
-                               double tolerance_sq,
-                               std::vector<bool>& keep) {
-    // this function is potentially ~similar speed to scalar for polylines with
-    // *randomly distributed* points, probably due to branch misprediction?
-    // the more points that can be obviated, the less recursion, faster speedup
-    if (end <= start + 1) {
-        return;
+FarthestPoint find_farthest_avx512(const PolylineSoA& points,
+                                   size_t start,
+                                   size_t end) {
+    return find_farthest_simd<8>(points, start, end);
+}
+
+void simplify_avx512(const PolylineSoA& input, double tolerance, SimplifyScratch& scratch) {
+    simplify_serial(input, tolerance, scratch, find_farthest_avx512);
+}
+
+/**
+ * Single-precision max-distance scan, 16 points per iteration. Indices are
+ * carried as int32 offsets from start.
+ */
+FarthestPoint find_farthest_avx512_f32(const PolylineSoAf& points,
+                                       size_t start,
+                                       size_t end) {
+    float px1 = points.x[start];
+    float py1 = points.y[start];
+    float seg_dx = points.x[end] - px1;
+    float seg_dy = points.y[end] - py1;
+    float seg_mag_sq = seg_dx * seg_dx + seg_dy * seg_dy;
+    const bool degenerate = seg_mag_sq < 1e-10f;
+
+    __m512 x1 = _mm512_set1_ps(px1);
+    __m512 y1 = _mm512_set1_ps(py1);
+    __m512 dx = _mm512_set1_ps(seg_dx);
+    __m512 dy = _mm512_set1_ps(seg_dy);
+
+    // mul/sub rather than fmsub so keys round like find_farthest_scalar_f32()
+    auto distance_key = [&](__m512 px, __m512 py) {
+        __m512 dpx = _mm512_sub_ps(px, x1);
+        __m512 dpy = _mm512_sub_ps(py, y1);
+        if (degenerate) {
+            return _mm512_add_ps(_mm512_mul_ps(dpx, dpx), _mm512_mul_ps(dpy, dpy));
+        }
+        __m512 cross = _mm512_sub_ps(_mm512_mul_ps(dpx, dy), _mm512_mul_ps(dpy, dx));
+        return _mm512_mul_ps(cross, cross);
+    };
+
+    // Aligned blocks of 16 over the 64-byte aligned storage, same scheme as
+    // find_farthest_avx512(). Offsets are relative to start.
+    const float* xs = points.x.data();
+    const float* ys = points.y.data();
+    size_t first = start + 1;
+    if (first >= end) {
+        return {0.0, start};
     }
-    
-    auto p_start = points[start];
-    auto p_end = points[end];
-    double max_dist_sq = 0.0;
-    // probably not worth it perf-wise to vectorize the max index tracking
-    // since it would require an extra horizontal operation
-    size_t max_idx = start;
+    size_t i = first & ~size_t{15};
+
+    __m512 vmax = _mm512_setzero_ps();
+    __m512i vidx = _mm512_setzero_si512();
+    __m512i cur_idx = _mm512_sub_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                                       _mm512_set1_epi32(static_cast<int>(start - i)));
+    const __m512i sixteen = _mm512_set1_epi32(16);
+
+    auto step = [&](__mmask16 mask, __m512 key) {
+        // strict gt keeps the first hit per lane, same as the scalar scan
+        __mmask16 gt = _mm512_mask_cmp_ps_mask(mask, key, vmax, _CMP_GT_OQ);
+        vmax = _mm512_mask_mov_ps(vmax, gt, key);
+        vidx = _mm512_mask_mov_epi32(vidx, gt, cur_idx);
+        cur_idx = _mm512_add_epi32(cur_idx, sixteen);
+    };
+
+    // Head block, which may also be the tail
+    __mmask16 head = static_cast<__mmask16>(0xFFFFu << (first - i));
+    if (end - i < 16) {
+        head &= static_cast<__mmask16>((1u << (end - i)) - 1);
+    }
+    step(head, distance_key(_mm512_maskz_load_ps(head, &xs[i]), _mm512_maskz_load_ps(head, &ys[i])));
+    i += 16;
+
+    for (; i + 16 <= end; i += 16) {
+        step(0xFFFF, distance_key(_mm512_load_ps(&xs[i]), _mm512_load_ps(&ys[i])));
+    }
+
+    if (i < end) {
+        __mmask16 tail = static_cast<__mmask16>((1u << (end - i)) - 1);
+        step(tail, distance_key(_mm512_maskz_load_ps(tail, &xs[i]), _mm512_maskz_load_ps(tail, &ys[i])));
+    }
+
+    alignas(64) float maxes[16];
+    alignas(64) int32_t offsets[16];
+    _mm512_store_ps(maxes, vmax);
+    _mm512_store_epi32(offsets, vidx);
+
+    float max_key = 0.0f;
+    int32_t max_offset = 0;
+    for (int j = 0; j < 16; ++j) {
+        if (maxes[j] > max_key || (maxes[j] == max_key && offsets[j] < max_offset)) {
+            max_key = maxes[j];
+            max_offset = offsets[j];
+        }
+    }
+
+    float max_dist_sq = degenerate ? max_key : max_key / seg_mag_sq;
+    return {max_dist_sq, start + static_cast<size_t>(max_offset)};
+}
+
+/**
+ * Fixed-point max-distance scan, 8 points per iteration. Coordinates are
+ * widened to int64 lanes and multiplied with mul_epi32 (32x32 -> 64 bit).
+ */
+FarthestPoint find_farthest_avx512_i32(const PolylineSoAi& points,
+                                       size_t start,
+                                       size_t end) {
+    int64_t px1 = points.x[start];
+    int64_t py1 = points.y[start];
+    int64_t seg_dx = points.x[end] - px1;
+    int64_t seg_dy = points.y[end] - py1;
+    int64_t chord_sq = seg_dx * seg_dx + seg_dy * seg_dy;
+    const bool degenerate = chord_sq == 0;
+
+    __m512i x1 = _mm512_set1_epi64(px1);
+    __m512i y1 = _mm512_set1_epi64(py1);
+    __m512i dx = _mm512_set1_epi64(seg_dx);
+    __m512i dy = _mm512_set1_epi64(seg_dy);
+
+    __m512i vmax = _mm512_setzero_si512();
+    __m512i vidx = _mm512_set1_epi64(static_cast<long long>(start));
     size_t i = start + 1;
-    
-    // Broadcast line segment endpoints (same for all 8 points)
-    __m512d x1 = _mm512_set1_pd(p_start.x);
-    __m512d y1 = _mm512_set1_pd(p_start.y);
-    __m512d x2 = _mm512_set1_pd(p_end.x);
-    __m512d y2 = _mm512_set1_pd(p_end.y);
-
-    // Precompute for all iterations
-    __m512d dx = _mm512_sub_pd(x2, x1);
-    __m512d dy = _mm512_sub_pd(y2, y1);
-    __m512d mag_sq = _mm512_fmadd_pd(dx, dx, _mm512_mul_pd(dy, dy));
-    
-    // Hot loop
-    for (; i + 7 < end; i += 8) {
-        // contiguous stride 1 loads now :)
-        __m512d px = _mm512_loadu_pd(&points.x[i]);
-        __m512d py = _mm512_loadu_pd(&points.y[i]);
-
-        // Calculate 8 distances in parallel
-        // calculate some intermediate values
-        __m512d dpx = _mm512_sub_pd(px, x1);
-        __m512d dpy = _mm512_sub_pd(py, y1);
-        __m512d cross1 = _mm512_mul_pd(dpx, dy);
-        __m512d cross2 = _mm512_mul_pd(dpy, dx);
-
-        // reduce intermediate products to cross product
-        __m512d cross = _mm512_sub_pd(cross1, cross2);
-        // calculate perpendicular distance by dividing segment length and square of cross product
-        __m512d dist_sq = _mm512_div_pd(_mm512_mul_pd(cross, cross), mag_sq);
-        
-        // keep if gt
-        // this should be fine for now, better to handle max_idx in scalar
-        double dists[8];
-        _mm512_storeu_pd(dists, dist_sq);
-        for (int j = 0; j < 8; ++j) {
-            if (dists[j] > max_dist_sq) {
-                max_dist_sq = dists[j];
-                max_idx = i + j;
-            }
+    __m512i cur_idx = _mm512_add_epi64(_mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7),
+                                       _mm512_set1_epi64(static_cast<long long>(i)));
+    const __m512i eight = _mm512_set1_epi64(8);
+
+    for (; i < end; i += 8) {
+        // masked tail, lanes past end are never loaded or compared
+        __mmask8 load = end - i >= 8 ? __mmask8(0xFF) : static_cast<__mmask8>((1u << (end - i)) - 1);
+        // 256-bit masked loads need AVX512VL, so load the low half of a zmm
+        // (extracted with a mask, GCC 12 warns on the cast's undefined upper half)
+        auto load8 = [load](const int32_t* p) {
+            __m256i low = _mm512_maskz_extracti64x4_epi64(0xF, _mm512_maskz_loadu_epi32(load, p), 0);
+            return _mm512_maskz_cvtepi32_epi64(0xFF, low);
+        };
+        __m512i px = load8(&points.x[i]);
+        __m512i py = load8(&points.y[i]);
+        __m512i dpx = _mm512_sub_epi64(px, x1);
+        __m512i dpy = _mm512_sub_epi64(py, y1);
+
+        __m512i key;
+        if (degenerate) {
+            key = _mm512_add_epi64(_mm512_maskz_mul_epi32(0xFF, dpx, dpx), _mm512_maskz_mul_epi32(0xFF, dpy, dpy));
+        } else {
+            key = _mm512_maskz_abs_epi64(0xFF, _mm512_sub_epi64(_mm512_maskz_mul_epi32(0xFF, dpx, dy), _mm512_maskz_mul_epi32(0xFF, dpy, dx)));
         }
+
+        // strict gt keeps the first hit per lane, same as the scalar scan
+        __mmask8 gt = _mm512_mask_cmpgt_epi64_mask(load, key, vmax);
+        vmax = _mm512_mask_mov_epi64(vmax, gt, key);
+        vidx = _mm512_mask_mov_epi64(vidx, gt, cur_idx);
+        cur_idx = _mm512_add_epi64(cur_idx, eight);
     }
-    
-    // Handle remainder with scalar code
-    for (; i < end; ++i) {
-        // scalar version
-        double dist_sq = perpendicular_distance(
-            points[i].x, points[i].y,
-            p_start.x, p_start.y,
-            p_end.x, p_end.y
-        );
-        
-        if (dist_sq > max_dist_sq) {
-            max_dist_sq = dist_sq;
-            max_idx = i;
+
+    alignas(64) long long maxes[8];
+    alignas(64) long long idxs[8];
+    _mm512_store_epi64(maxes, vmax);
+    _mm512_store_epi64(idxs, vidx);
+
+    int64_t max_key = 0;
+    size_t max_idx = start;
+    for (int j = 0; j < 8; ++j) {
+        size_t idx = static_cast<size_t>(idxs[j]);
+        if (maxes[j] > max_key || (maxes[j] == max_key && idx < max_idx)) {
+            max_key = maxes[j];
+            max_idx = idx;
         }
     }
 
-    // If max distance exceeds epsilon, keep point and recurse
-    if (max_dist_sq > tolerance_sq) {
-        keep[max_idx] = true;
-        rdpr_avx512(points, start, max_idx, tolerance_sq, keep);
-        rdpr_avx512(points, max_idx, end, tolerance_sq, keep);
+    return {fixed_point_dist_sq(max_key, chord_sq), max_idx};
+}
+
+void sweep_level_avx512(const PolylineSoA& points, const Segment* segs, size_t count,
+                        FarthestPoint* out, const PackedLanes& lanes_in) {
+    const double* x = points.x.data();
+    const double* y = points.y.data();
+
+    // Local copy: the vector stores may alias anything, including lanes_in
+    const PackedLanes packed = lanes_in;
+
+    const __m512i iota = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m512i eight = _mm512_set1_epi64(8);
+    size_t lanes = 0;
+    size_t slots = 0;
+
+    // Pass 1: distance keys, packed. Same mul/sub key as the scalar and
+    // per-segment scans, so the keep set doesn't depend on the execution mode.
+    for (size_t j = 0; j < count; ++j) {
+        size_t start = segs[j].start;
+        size_t end = segs[j].end;
+        size_t interior = end - start - 1;
+
+        double seg_dx = x[end] - x[start];
+        double seg_dy = y[end] - y[start];
+        double mag_sq = seg_dx * seg_dx + seg_dy * seg_dy;
+
+        if (interior >= kPackedMaxInterior || mag_sq < 1e-10) {
+            out[j] = find_farthest_avx512(points, start, end);
+            continue;
+        }
+
+        __m512d x1 = _mm512_set1_pd(x[start]);
+        __m512d y1 = _mm512_set1_pd(y[start]);
+        __m512d dx = _mm512_set1_pd(seg_dx);
+        __m512d dy = _mm512_set1_pd(seg_dy);
+        __m512i vslot = _mm512_set1_epi64(static_cast<long long>(slots));
+        __m512i vpoint = _mm512_add_epi64(iota, _mm512_set1_epi64(static_cast<long long>(start + 1)));
+
+        for (size_t k = 0; k < interior; k += 8) {
+            __mmask8 load = interior - k >= 8 ? __mmask8(0xFF)
+                                              : static_cast<__mmask8>((1u << (interior - k)) - 1);
+            __m512d dpx = _mm512_sub_pd(_mm512_maskz_loadu_pd(load, &x[start + 1 + k]), x1);
+            __m512d dpy = _mm512_sub_pd(_mm512_maskz_loadu_pd(load, &y[start + 1 + k]), y1);
+            __m512d cross = _mm512_sub_pd(_mm512_mul_pd(dpx, dy), _mm512_mul_pd(dpy, dx));
+
+            _mm512_storeu_pd(&packed.key[lanes + k], _mm512_mul_pd(cross, cross));
+            _mm512_storeu_si512(&packed.point[lanes + k], vpoint);
+            _mm512_storeu_si512(&packed.slot[lanes + k], vslot);
+            vpoint = _mm512_add_epi64(vpoint, eight);
+        }
+
+        lanes += interior;
+        packed.last[slots] = lanes - 1;
+        packed.segment[slots] = j;
+        ++slots;
+    }
+
+    // Pass 2: segmented running argmax over all lanes at once, 8 at a time.
+    // Slots never decrease along the lanes, so two lanes with the same slot
+    // belong to one segment along with everything between them. Taking the
+    // earlier lane on >= keeps the lowest index on ties, like the scans.
+    const __m512i shift1 = _mm512_setr_epi64(0, 0, 1, 2, 3, 4, 5, 6);
+    const __m512i shift2 = _mm512_setr_epi64(0, 0, 0, 1, 2, 3, 4, 5);
+    const __m512i shift4 = _mm512_setr_epi64(0, 0, 0, 0, 0, 1, 2, 3);
+    const __m512i lane7 = _mm512_set1_epi64(7);
+
+    __m512d carry_key = _mm512_setzero_pd();
+    __m512i carry_idx = _mm512_setzero_si512();
+    __m512i carry_slot = _mm512_set1_epi64(-1);
+
+    for (size_t k = 0; k < lanes; k += 8) {
+        __m512d key = _mm512_loadu_pd(&packed.key[k]);
+        __m512i idx = _mm512_loadu_si512(&packed.point[k]);
+        __m512i vslot = _mm512_loadu_si512(&packed.slot[k]);
+
+        auto combine = [&](__m512d other_key, __m512i other_idx, __m512i other_slot, __mmask8 reach) {
+            __mmask8 take = _mm512_mask_cmpeq_epi64_mask(reach, other_slot, vslot) &
+                            _mm512_cmp_pd_mask(other_key, key, _CMP_GE_OQ);
+            key = _mm512_mask_mov_pd(key, take, other_key);
+            idx = _mm512_mask_mov_epi64(idx, take, other_idx);
+        };
+
+        // Lane j looks at lane j - s (masked permutes only because GCC 12
+        // flags the unmasked ones' undefined passthrough as maybe-uninitialized)
+        auto scan_step = [&](__m512i shift, __mmask8 reach) {
+            combine(_mm512_mask_permutexvar_pd(key, reach, shift, key),
+                    _mm512_mask_permutexvar_epi64(idx, reach, shift, idx),
+                    _mm512_mask_permutexvar_epi64(vslot, reach, shift, vslot), reach);
+        };
+        scan_step(shift1, 0xFE);
+        scan_step(shift2, 0xFC);
+        scan_step(shift4, 0xF0);
+
+        // Fold in the segment still running from the previous vector
+        combine(carry_key, carry_idx, carry_slot, 0xFF);
+
+        _mm512_storeu_pd(&packed.key[k], key);
+        _mm512_storeu_si512(&packed.point[k], idx);
+
+        carry_key = _mm512_mask_permutexvar_pd(key, 0xFF, lane7, key);
+        carry_idx = _mm512_mask_permutexvar_epi64(idx, 0xFF, lane7, idx);
+        carry_slot = _mm512_mask_permutexvar_epi64(vslot, 0xFF, lane7, vslot);
+    }
+
+    // Each segment's argmax sits in its last lane
+    for (size_t s = 0; s < slots; ++s) {
+        size_t j = packed.segment[s];
+        double max_key = packed.key[packed.last[s]];
+        size_t max_idx = max_key > 0.0 ? static_cast<size_t>(packed.point[packed.last[s]])
+                                       : segs[j].start;
+
+        double seg_dx = x[segs[j].end] - x[segs[j].start];
+        double seg_dy = y[segs[j].end] - y[segs[j].start];
+        out[j] = {max_key / (seg_dx * seg_dx + seg_dy * seg_dy), max_idx};
     }
 }
 
-PolylineSoA simplify_avx512(const PolylineSoA& input, double tolerance) {
-    if (input.size() <= 2) {
-        return input;
+size_t filter_significant_avx512(const double* x, const double* y, const double* significance,
+                                 size_t n, double threshold, double* out_x, double* out_y) {
+    return filter_significant_simd<8>(x, y, significance, n, threshold, out_x, out_y);
+}
+
+void triangle_areas_avx512(const double* x, const double* y, size_t n, double* areas) {
+    // mul/sub without FMA so the areas round exactly like triangle_area()
+    const __m512d half = _mm512_set1_pd(0.5);
+
+    auto areas8 = [&](__mmask8 mask, size_t i) {
+        __m512d x0 = _mm512_maskz_loadu_pd(mask, &x[i - 1]);
+        __m512d y0 = _mm512_maskz_loadu_pd(mask, &y[i - 1]);
+        __m512d ax = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, &x[i]), x0);
+        __m512d ay = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, &y[i]), y0);
+        __m512d bx = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, &x[i + 1]), x0);
+        __m512d by = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, &y[i + 1]), y0);
+
+        __m512d cross = _mm512_sub_pd(_mm512_mul_pd(ax, by), _mm512_mul_pd(ay, bx));
+        __m512d area = _mm512_mul_pd(half, _mm512_abs_pd(cross));
+        _mm512_mask_storeu_pd(&areas[i], mask, area);
+    };
+
+    size_t i = 1;
+    for (; i + 8 < n; i += 8) {
+        areas8(0xFF, i);
+    }
+
+    // masked tail over the remaining interior points
+    if (i + 1 < n) {
+        areas8(static_cast<__mmask8>((1u << (n - 1 - i)) - 1), i);
     }
-    
-    // Square the tolerance to avoid sqrt in distance calculations
-    double tolerance_sq = tolerance * tolerance;
-    
-    // Mark which points to keep
-    std::vector<bool> keep(input.size(), false);
-    keep[0] = true;  // Always keep first point
-    keep[input.size() - 1] = true;  // Always keep last point
-    
-    // Run the recursive algorithm
-    rdpr_avx512(input, 0, input.size() - 1, tolerance_sq, keep);
-    
-    // Build the result
-    PolylineSoA result;
-    result.reserve(input.size());  // Upper bound
-    
-    for (size_t i = 0; i < input.size(); ++i) {
-        if (keep[i]) {
-            result.push_back(input[i].x, input[i].y);
+
+    areas[0] = std::numeric_limits<double>::infinity();
+    areas[n - 1] = std::numeric_limits<double>::infinity();
+}
+
+size_t find_exit_avx512(const double* x, const double* y, size_t n,
+                        double kx, double ky, double dx, double dy, double limit) {
+    __m512d vkx = _mm512_set1_pd(kx);
+    __m512d vky = _mm512_set1_pd(ky);
+    __m512d vdx = _mm512_set1_pd(dx);
+    __m512d vdy = _mm512_set1_pd(dy);
+    __m512d vlimit = _mm512_set1_pd(limit);
+
+    for (size_t i = 0; i < n; i += 8) {
+        // masked tail, lanes past n are never loaded or reported
+        __mmask8 load = n - i >= 8 ? __mmask8(0xFF) : static_cast<__mmask8>((1u << (n - i)) - 1);
+        __m512d dpx = _mm512_sub_pd(_mm512_maskz_loadu_pd(load, &x[i]), vkx);
+        __m512d dpy = _mm512_sub_pd(_mm512_maskz_loadu_pd(load, &y[i]), vky);
+        // mul/sub, not fmsub, so the key matches strip_cross_sq() exactly
+        __m512d cross = _mm512_sub_pd(_mm512_mul_pd(dpx, vdy), _mm512_mul_pd(dpy, vdx));
+        __mmask8 outside = _mm512_mask_cmp_pd_mask(load, _mm512_mul_pd(cross, cross), vlimit, _CMP_GT_OQ);
+        if (outside) {
+            return i + static_cast<size_t>(__builtin_ctz(outside));
         }
     }
-    
-    return result;
+    return n;
 }
 
+size_t radial_filter_avx512(const double* x, const double* y, size_t n,
+                            double tolerance_sq, double* out_x, double* out_y) {
+    __m512d vtolerance = _mm512_set1_pd(tolerance_sq);
+
+    // mul/add, not fmadd, so distances round like radial_filter_scalar()
+    auto far_from = [&](__mmask8 load, __m512d px, __m512d py, __m512d kx, __m512d ky) {
+        __m512d dx = _mm512_sub_pd(px, kx);
+        __m512d dy = _mm512_sub_pd(py, ky);
+        __m512d dist_sq = _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy));
+        return _mm512_mask_cmp_pd_mask(load, dist_sq, vtolerance, _CMP_GT_OQ);
+    };
+
+    out_x[0] = x[0];
+    out_y[0] = y[0];
+    size_t count = 1;
+    size_t key = 0;
+    __m512d kx = _mm512_set1_pd(x[0]);
+    __m512d ky = _mm512_set1_pd(y[0]);
+
+    size_t i = 1;
+    while (i < n) {
+        // masked tail, lanes past n are never loaded or kept
+        __mmask8 load = n - i >= 8 ? __mmask8(0xFF) : static_cast<__mmask8>((1u << (n - i)) - 1);
+        __m512d px = _mm512_maskz_loadu_pd(load, &x[i]);
+        __m512d py = _mm512_maskz_loadu_pd(load, &y[i]);
+
+        unsigned far_key = far_from(load, px, py, kx, ky);
+        if (!far_key) {
+            i += 8;
+            continue;
+        }
+
+        // The first lane clear of the key is kept. Each lane after it is
+        // kept for as long as it's clear of its predecessor, which is then
+        // the key; the first that isn't restarts the scan against a new key.
+        unsigned far_prev = far_from(load, px, py,
+                                     _mm512_maskz_loadu_pd(load, &x[i - 1]),
+                                     _mm512_maskz_loadu_pd(load, &y[i - 1]));
+        unsigned first = static_cast<unsigned>(__builtin_ctz(far_key));
+        unsigned stop = first + 1 + static_cast<unsigned>(__builtin_ctz(~(far_prev >> (first + 1))));
+
+        __mmask8 kept = static_cast<__mmask8>(((1u << stop) - 1) & ~((1u << first) - 1));
+        _mm512_mask_compressstoreu_pd(&out_x[count], kept, px);
+        _mm512_mask_compressstoreu_pd(&out_y[count], kept, py);
+        count += stop - first;
+
+        key = i + stop - 1;
+        kx = _mm512_set1_pd(x[key]);
+        ky = _mm512_set1_pd(y[key]);
+        i += stop;
+    }
+
+    // The last point is always kept, however close it is
+    if (key != n - 1) {
+        out_x[count] = x[n - 1];
+        out_y[count] = y[n - 1];
+        ++count;
+    }
+
+    return count;
+}
 
 #endif // HAVE_AVX512
 
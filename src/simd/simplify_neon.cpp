@@ -6,7 +6,7 @@ namespace internal {
 
 #ifdef HAVE_NEON
 
-PolylineSoA simplify_neon(const PolylineSoA& input, double tolerance) {
+void simplify_neon(const PolylineSoA& input, double tolerance, SimplifyScratch& scratch) {
     // TODO: Implement ARM NEON version
     //
     // Key optimizations:
@@ -37,7 +37,7 @@ PolylineSoA simplify_neon(const PolylineSoA& input, double tolerance) {
     // - Apple Silicon optimization guide
     
     // For now, fall back to scalar implementation
-    return simplify_scalar(input, tolerance);
+    simplify_scalar(input, tolerance, scratch);
 }
 
 #endif // HAVE_NEON
@@ -0,0 +1,57 @@
+#include "geom_simd/internal/simd_kernels.h"
+#include "geom_simd/internal/simplify_internal.h"
+
+namespace geom {
+namespace internal {
+
+#ifdef HAVE_SSE2
+
+// The x86-64 baseline, for hosts (often VMs) that hide AVX. Everything is
+// the shared kernels at width 2; the f32 and i32 scans stay scalar.
+
+/**
+ * Max-distance scan in SSE2, 2 points per iteration
+ *
+ * @param points Input points
+ * @param start Start index (inclusive)
+ * @param end End index (inclusive)
+ * @return Farthest interior point and its squared distance
+ */
+FarthestPoint find_farthest_sse2(const PolylineSoA& points,
+                                 size_t start,
+                                 size_t end) {
+    return find_farthest_simd<2>(points, start, end);
+}
+
+void simplify_sse2(const PolylineSoA& input, double tolerance, SimplifyScratch& scratch) {
+    simplify_serial(input, tolerance, scratch, find_farthest_sse2);
+}
+
+void sweep_level_sse2(const PolylineSoA& points, const Segment* segs, size_t count,
+                      FarthestPoint* out, const PackedLanes&) {
+    sweep_level_with(points, segs, count, out, find_farthest_sse2);
+}
+
+size_t filter_significant_sse2(const double* x, const double* y, const double* significance,
+                               size_t n, double threshold, double* out_x, double* out_y) {
+    return filter_significant_simd<2>(x, y, significance, n, threshold, out_x, out_y);
+}
+
+void triangle_areas_sse2(const double* x, const double* y, size_t n, double* areas) {
+    triangle_areas_simd<2>(x, y, n, areas);
+}
+
+size_t find_exit_sse2(const double* x, const double* y, size_t n,
+                      double kx, double ky, double dx, double dy, double limit) {
+    return find_exit_simd<2>(x, y, n, kx, ky, dx, dy, limit);
+}
+
+size_t radial_filter_sse2(const double* x, const double* y, size_t n,
+                          double tolerance_sq, double* out_x, double* out_y) {
+    return radial_filter_simd<2>(x, y, n, tolerance_sq, out_x, out_y);
+}
+
+#endif // HAVE_SSE2
+
+} // namespace internal
+} // namespace geom
@@ -1,6 +1,8 @@
 #include "geom_simd/geom_simd.h"
 #include "geom_simd/internal/simplify_internal.h"
+#include <limits>
 #include <stdexcept>
+#include <utility>
 
 #ifdef __x86_64__
 #include <cpuid.h>
@@ -12,15 +14,34 @@ namespace {
 
 // Runtime CPU feature detection
 SIMDCapabilities detect_capabilities() {
-    SIMDCapabilities caps{false, false, false};
+    SIMDCapabilities caps{false, false, false, false};
     
 #ifdef __x86_64__
     unsigned int eax, ebx, ecx, edx;
     
+    // The AVX2 kernels are also built with -mfma, and both need the OS to
+    // save the wider registers (OSXSAVE, then XCR0), or the first vector
+    // instruction faults even though CPUID lists it
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return caps;
+    }
+    caps.sse2_available = (edx & (1u << 26)) != 0;  // Always set on x86-64
+    bool fma = (ecx & (1u << 12)) != 0;
+    bool osxsave = (ecx & (1u << 27)) != 0;
+    bool avx = (ecx & (1u << 28)) != 0;
+    if (!osxsave || !avx) {
+        return caps;
+    }
+    
+    unsigned int xcr0_lo, xcr0_hi;
+    __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    bool ymm_state = (xcr0_lo & 0x6) == 0x6;     // SSE + AVX state
+    bool zmm_state = (xcr0_lo & 0xE6) == 0xE6;   // + opmask and upper ZMM state
+    
     // Check for AVX2 (CPUID.7.0.EBX[5])
     if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
-        caps.avx2_available = (ebx & (1 << 5)) != 0;
-        caps.avx512_available = (ebx & (1 << 16)) != 0; // AVX512F
+        caps.avx2_available = ymm_state && fma && (ebx & (1 << 5)) != 0;
+        caps.avx512_available = zmm_state && (ebx & (1 << 16)) != 0; // AVX512F
     }
 #endif
 
@@ -29,6 +50,20 @@ SIMDCapabilities detect_capabilities() {
     caps.neon_available = true;
 #endif
 
+    // Only report kernels this build of the library contains
+#ifndef HAVE_AVX2
+    caps.avx2_available = false;
+#endif
+#ifndef HAVE_AVX512
+    caps.avx512_available = false;
+#endif
+#ifndef HAVE_NEON
+    caps.neon_available = false;
+#endif
+#ifndef HAVE_SSE2
+    caps.sse2_available = false;
+#endif
+
     return caps;
 }
 
@@ -39,53 +74,105 @@ SIMDCapabilities get_simd_capabilities() {
     return caps;
 }
 
-PolylineSoA simplify(const PolylineSoA& input, 
-                  double tolerance,
-                  SimplifyAlgorithm algorithm) {
-    // Early exit for trivial cases
-    if (input.size() <= 2) {
-        return input;
-    }
-    
-    if (tolerance <= 0.0) {
-        throw std::invalid_argument("Tolerance must be positive");
-    }
+namespace internal {
+
+namespace {
+
+const SimplifyBackend kScalarBackend = {
+    simplify_scalar, find_farthest_scalar, filter_significant_scalar,
+    triangle_areas_scalar, sweep_level_scalar, find_exit_scalar,
+    radial_filter_scalar, find_farthest_scalar_f32,
+    find_farthest_scalar_i32,
+};
+
+#ifdef HAVE_SSE2
+// No f32 or i32 kernels at this width
+const SimplifyBackend kSse2Backend = {
+    simplify_sse2, find_farthest_sse2, filter_significant_sse2,
+    triangle_areas_sse2, sweep_level_sse2, find_exit_sse2,
+    radial_filter_sse2, find_farthest_scalar_f32,
+    find_farthest_scalar_i32,
+};
+#endif
+
+#ifdef HAVE_AVX2
+const SimplifyBackend kAvx2Backend = {
+    simplify_avx2, find_farthest_avx2, filter_significant_avx2,
+    triangle_areas_avx2, sweep_level_avx2, find_exit_avx2,
+    radial_filter_avx2, find_farthest_avx2_f32,
+    find_farthest_avx2_i32,
+};
+#endif
+
+#ifdef HAVE_AVX512
+const SimplifyBackend kAvx512Backend = {
+    simplify_avx512, find_farthest_avx512, filter_significant_avx512,
+    triangle_areas_avx512, sweep_level_avx512, find_exit_avx512,
+    radial_filter_avx512, find_farthest_avx512_f32,
+    find_farthest_avx512_i32,
+};
+#endif
+
+#ifdef HAVE_NEON
+// NEON scan is still a TODO, see simplify_neon.cpp
+const SimplifyBackend kNeonBackend = {
+    simplify_neon, find_farthest_scalar, filter_significant_scalar,
+    triangle_areas_scalar, sweep_level_scalar, find_exit_scalar,
+    radial_filter_scalar, find_farthest_scalar_f32,
+    find_farthest_scalar_i32,
+};
+#endif
+
+} // anonymous namespace
+
+// The widest ISA the CPU has whose crossover size n reaches
+SimplifyBackend auto_backend(size_t n, const DispatchProfile& profile) {
+    auto caps = get_simd_capabilities();
     
-    // Dispatch to appropriate implementation
-    if (algorithm == SimplifyAlgorithm::AUTO) {
-        auto caps = get_simd_capabilities();
-        
-        // Prefer fastest available implementation
 #ifdef HAVE_AVX512
-        if (caps.avx512_available) {
-            return internal::simplify_avx512(input, tolerance);
-        }
+    if (caps.avx512_available && n >= profile.avx512_min_points) {
+        return kAvx512Backend;
+    }
 #endif
 #ifdef HAVE_AVX2
-        if (caps.avx2_available) {
-            return internal::simplify_avx2(input, tolerance);
-        }
+    if (caps.avx2_available && n >= profile.avx2_min_points) {
+        return kAvx2Backend;
+    }
+#endif
+#ifdef HAVE_SSE2
+    if (caps.sse2_available && n >= profile.sse2_min_points) {
+        return kSse2Backend;
+    }
 #endif
 #ifdef HAVE_NEON
-        if (caps.neon_available) {
-            return internal::simplify_neon(input, tolerance);
-        }
+    if (caps.neon_available && n >= profile.neon_min_points) {
+        return kNeonBackend;
+    }
 #endif
-        // Fall back to scalar
-        return internal::simplify_scalar(input, tolerance);
+    (void)caps;
+    (void)n;
+    (void)profile;
+    // Fall back to scalar
+    return kScalarBackend;
+}
+
+// Resolve AUTO and make sure an explicitly requested ISA is usable
+SimplifyBackend select_backend(SimplifyAlgorithm algorithm, size_t n) {
+    if (algorithm == SimplifyAlgorithm::AUTO) {
+        return auto_backend(n, get_dispatch_profile());
     }
     
     // Explicit algorithm selection
     switch (algorithm) {
         case SimplifyAlgorithm::SCALAR:
-            return internal::simplify_scalar(input, tolerance);
+            return kScalarBackend;
             
 #ifdef HAVE_AVX2
         case SimplifyAlgorithm::AVX2:
             if (!get_simd_capabilities().avx2_available) {
                 throw std::runtime_error("AVX2 not available on this CPU");
             }
-            return internal::simplify_avx2(input, tolerance);
+            return kAvx2Backend;
 #endif
 
 #ifdef HAVE_AVX512
@@ -93,7 +180,15 @@ PolylineSoA simplify(const PolylineSoA& input,
             if (!get_simd_capabilities().avx512_available) {
                 throw std::runtime_error("AVX-512 not available on this CPU");
             }
-            return internal::simplify_avx512(input, tolerance);
+            return kAvx512Backend;
+#endif
+
+#ifdef HAVE_SSE2
+        case SimplifyAlgorithm::SSE2:
+            if (!get_simd_capabilities().sse2_available) {
+                throw std::runtime_error("SSE2 not available on this CPU");
+            }
+            return kSse2Backend;
 #endif
 
 #ifdef HAVE_NEON
@@ -101,7 +196,7 @@ PolylineSoA simplify(const PolylineSoA& input,
             if (!get_simd_capabilities().neon_available) {
                 throw std::runtime_error("NEON not available on this CPU");
             }
-            return internal::simplify_neon(input, tolerance);
+            return kNeonBackend;
 #endif
 
         default:
@@ -109,4 +204,262 @@ PolylineSoA simplify(const PolylineSoA& input,
     }
 }
 
+} // namespace internal
+
+namespace {
+
+// Run the selected back end, leaving the keep bitset in scratch.keep
+void mark_kept(const PolylineSoA& input,
+               double tolerance,
+               const SimplifyOptions& options,
+               SimplifyScratch& scratch) {
+    internal::SimplifyBackend backend = internal::select_backend(options.algorithm, input.size());
+    
+    SimplifyExecution execution = options.execution;
+    if (execution == SimplifyExecution::AUTO) {
+        execution = input.size() >= get_dispatch_profile().parallel_min_points
+                        ? SimplifyExecution::PARALLEL
+                        : SimplifyExecution::SERIAL;
+    }
+    
+    switch (execution) {
+        case SimplifyExecution::PARALLEL:
+            internal::simplify_parallel(input, tolerance, scratch, backend.find_farthest,
+                                        options.num_threads, options.parallel_threshold);
+            return;
+            
+        case SimplifyExecution::BREADTH_FIRST:
+            internal::simplify_breadth_first(input, tolerance, scratch, backend.sweep_level);
+            return;
+            
+        case SimplifyExecution::SERIAL:
+        default:
+            backend.simplify(input, tolerance, scratch);
+            return;
+    }
+}
+
+// Copy the points whose keep bit is set. Sized up front so a reused output
+// with enough capacity is filled without reallocating.
+template <typename T>
+void gather_kept(const BasicPolylineSoA<T>& input,
+                 const std::vector<uint64_t>& keep,
+                 BasicPolylineSoA<T>& output) {
+    size_t count = 0;
+    for (uint64_t word : keep) {
+        count += static_cast<size_t>(__builtin_popcountll(word));
+    }
+    
+    output.x.resize(count);
+    output.y.resize(count);
+    
+    size_t out = 0;
+    for (size_t w = 0; w < keep.size(); ++w) {
+        uint64_t word = keep[w];
+        while (word) {
+            size_t i = w * 64 + static_cast<size_t>(__builtin_ctzll(word));
+            output.x[out] = input.x[i];
+            output.y[out] = input.y[i];
+            ++out;
+            word &= word - 1;
+        }
+    }
+}
+
+// Validate arguments and fill scratch.keep. Lines with <= 2 points keep
+// every vertex and skip the tolerance check, same as simplify().
+void compute_keep_mask(const PolylineSoA& input,
+                       double tolerance,
+                       const SimplifyOptions& options,
+                       SimplifyScratch& scratch) {
+    size_t n = input.size();
+    if (n <= 2) {
+        scratch.keep.assign(internal::keep_words(n), 0);
+        for (size_t i = 0; i < n; ++i) {
+            internal::set_keep(scratch.keep, i);
+        }
+        return;
+    }
+    
+    if (tolerance <= 0.0) {
+        throw std::invalid_argument("Tolerance must be positive");
+    }
+    
+    mark_kept(input, tolerance, options, scratch);
+}
+
+SimplifyOptions options_for(SimplifyAlgorithm algorithm) {
+    SimplifyOptions options;
+    options.algorithm = algorithm;
+    return options;
+}
+
+} // anonymous namespace
+
+void simplify_indices_into(const PolylineSoA& input,
+                           double tolerance,
+                           std::vector<size_t>& indices,
+                           SimplifyScratch& scratch,
+                           SimplifyAlgorithm algorithm) {
+    compute_keep_mask(input, tolerance, options_for(algorithm), scratch);
+    
+    indices.clear();
+    for (size_t w = 0; w < scratch.keep.size(); ++w) {
+        uint64_t word = scratch.keep[w];
+        while (word) {
+            indices.push_back(w * 64 + static_cast<size_t>(__builtin_ctzll(word)));
+            word &= word - 1;
+        }
+    }
+}
+
+std::vector<size_t> simplify_indices(const PolylineSoA& input,
+                                     double tolerance,
+                                     SimplifyAlgorithm algorithm) {
+    std::vector<size_t> indices;
+    SimplifyScratch scratch;
+    simplify_indices_into(input, tolerance, indices, scratch, algorithm);
+    return indices;
+}
+
+std::vector<uint64_t> simplify_mask(const PolylineSoA& input,
+                                    double tolerance,
+                                    SimplifyAlgorithm algorithm) {
+    SimplifyScratch scratch;
+    compute_keep_mask(input, tolerance, options_for(algorithm), scratch);
+    return std::move(scratch.keep);
+}
+
+void simplify_into(const PolylineSoA& input,
+                   double tolerance,
+                   PolylineSoA& output,
+                   SimplifyScratch& scratch,
+                   const SimplifyOptions& options) {
+    // Early exit for trivial cases
+    if (input.size() <= 2) {
+        output.x.assign(input.x.begin(), input.x.end());
+        output.y.assign(input.y.begin(), input.y.end());
+        return;
+    }
+    
+    if (tolerance <= 0.0) {
+        throw std::invalid_argument("Tolerance must be positive");
+    }
+    
+    if (!options.radial_prefilter) {
+        mark_kept(input, tolerance, options, scratch);
+        gather_kept(input, scratch.keep, output);
+        return;
+    }
+    
+    // Douglas-Peucker then only sees the pre-pass survivors
+    internal::RadialFilterFn radial_filter =
+        internal::select_backend(options.algorithm, input.size()).radial_filter;
+    
+    PolylineSoA& filtered = scratch.prefiltered;
+    filtered.x.resize(input.size());
+    filtered.y.resize(input.size());
+    size_t count = radial_filter(input.x.data(), input.y.data(), input.size(),
+                                 tolerance * tolerance, filtered.x.data(), filtered.y.data());
+    filtered.x.resize(count);
+    filtered.y.resize(count);
+    
+    if (count <= 2) {
+        output.x.assign(filtered.x.begin(), filtered.x.end());
+        output.y.assign(filtered.y.begin(), filtered.y.end());
+        return;
+    }
+    
+    mark_kept(filtered, tolerance, options, scratch);
+    gather_kept(filtered, scratch.keep, output);
+}
+
+void simplify_into(const PolylineSoA& input,
+                   double tolerance,
+                   PolylineSoA& output,
+                   SimplifyScratch& scratch,
+                   SimplifyAlgorithm algorithm) {
+    simplify_into(input, tolerance, output, scratch, options_for(algorithm));
+}
+
+PolylineSoA simplify(const PolylineSoA& input,
+                     double tolerance,
+                     const SimplifyOptions& options) {
+    PolylineSoA result;
+    SimplifyScratch scratch;
+    simplify_into(input, tolerance, result, scratch, options);
+    return result;
+}
+
+PolylineSoA simplify(const PolylineSoA& input, 
+                  double tolerance,
+                  SimplifyAlgorithm algorithm) {
+    return simplify(input, tolerance, options_for(algorithm));
+}
+
+void simplify_into(const PolylineSoAf& input,
+                   double tolerance,
+                   PolylineSoAf& output,
+                   SimplifyScratch& scratch,
+                   SimplifyAlgorithm algorithm) {
+    if (input.size() <= 2) {
+        output.x.assign(input.x.begin(), input.x.end());
+        output.y.assign(input.y.begin(), input.y.end());
+        return;
+    }
+    
+    if (tolerance <= 0.0) {
+        throw std::invalid_argument("Tolerance must be positive");
+    }
+    
+    // The float kernels carry indices in 32-bit lanes
+    if (input.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        throw std::invalid_argument("Single-precision lines are limited to 2^31 - 1 points");
+    }
+    
+    internal::FindFarthestF32Fn find_farthest =
+        internal::select_backend(algorithm, input.size()).find_farthest_f32;
+    internal::simplify_with(input, tolerance, scratch, find_farthest);
+    gather_kept(input, scratch.keep, output);
+}
+
+PolylineSoAf simplify(const PolylineSoAf& input,
+                      double tolerance,
+                      SimplifyAlgorithm algorithm) {
+    PolylineSoAf result;
+    SimplifyScratch scratch;
+    simplify_into(input, tolerance, result, scratch, algorithm);
+    return result;
+}
+
+void simplify_into(const PolylineSoAi& input,
+                   double tolerance,
+                   PolylineSoAi& output,
+                   SimplifyScratch& scratch,
+                   SimplifyAlgorithm algorithm) {
+    if (input.size() <= 2) {
+        output.x.assign(input.x.begin(), input.x.end());
+        output.y.assign(input.y.begin(), input.y.end());
+        return;
+    }
+    
+    if (tolerance <= 0.0) {
+        throw std::invalid_argument("Tolerance must be positive");
+    }
+    
+    internal::FindFarthestI32Fn find_farthest =
+        internal::select_backend(algorithm, input.size()).find_farthest_i32;
+    internal::simplify_with(input, tolerance, scratch, find_farthest);
+    gather_kept(input, scratch.keep, output);
+}
+
+PolylineSoAi simplify(const PolylineSoAi& input,
+                      double tolerance,
+                      SimplifyAlgorithm algorithm) {
+    PolylineSoAi result;
+    SimplifyScratch scratch;
+    simplify_into(input, tolerance, result, scratch, algorithm);
+    return result;
+}
+
 } // namespace geom
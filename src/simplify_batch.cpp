@@ -0,0 +1,102 @@
+#include "geom_simd/geom_simd.h"
+#include "geom_simd/internal/thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+namespace geom {
+
+namespace {
+
+// Aim for a few chunks per thread so stealing can even out the tail, but
+// keep chunks big enough that task overhead stays noise
+constexpr size_t kChunksPerThread = 8;
+constexpr size_t kMinChunkPoints = 4096;
+
+void simplify_range(const PolylineSoA* inputs,
+                    PolylineSoA* outputs,
+                    size_t begin,
+                    size_t end,
+                    double tolerance,
+                    SimplifyAlgorithm algorithm) {
+    // One scratch per thread, kept across batches
+    thread_local SimplifyScratch scratch;
+    for (size_t i = begin; i < end; ++i) {
+        simplify_into(inputs[i], tolerance, outputs[i], scratch, algorithm);
+    }
+}
+
+} // anonymous namespace
+
+void simplify_batch(const PolylineSoA* inputs,
+                    PolylineSoA* outputs,
+                    size_t count,
+                    double tolerance,
+                    SimplifyAlgorithm algorithm,
+                    size_t num_threads) {
+    if (count == 0) {
+        return;
+    }
+    
+    // Fail up front rather than from inside a worker
+    if (tolerance <= 0.0) {
+        throw std::invalid_argument("Tolerance must be positive");
+    }
+    
+    size_t threads = internal::clamp_threads(num_threads);
+    if (threads == 1) {
+        simplify_range(inputs, outputs, 0, count, tolerance, algorithm);
+        return;
+    }
+    
+    // Balance by point count, not line count
+    size_t total_points = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total_points += inputs[i].size();
+    }
+    size_t chunk_points = std::max(kMinChunkPoints,
+                                   total_points / (threads * kChunksPerThread));
+    
+    std::vector<size_t> chunk_ends;
+    size_t points = 0;
+    for (size_t i = 0; i < count; ++i) {
+        points += inputs[i].size();
+        if (points >= chunk_points || i + 1 == count) {
+            chunk_ends.push_back(i + 1);
+            points = 0;
+        }
+    }
+    
+    // The pool is shared and sized to the machine, so the thread limit is
+    // the number of tasks: each one pulls chunks until none are left
+    std::atomic<size_t> next_chunk{0};
+    auto drain = [&] {
+        for (;;) {
+            size_t c = next_chunk.fetch_add(1, std::memory_order_relaxed);
+            if (c >= chunk_ends.size()) {
+                return;
+            }
+            size_t begin = c == 0 ? 0 : chunk_ends[c - 1];
+            simplify_range(inputs, outputs, begin, chunk_ends[c], tolerance, algorithm);
+        }
+    };
+    
+    auto& pool = internal::shared_thread_pool();
+    internal::TaskGroup group;
+    for (size_t t = 0; t < std::min(threads, chunk_ends.size()); ++t) {
+        pool.submit(group, drain);
+    }
+    pool.wait(group);
+}
+
+void simplify_batch(const std::vector<PolylineSoA>& inputs,
+                    std::vector<PolylineSoA>& outputs,
+                    double tolerance,
+                    SimplifyAlgorithm algorithm,
+                    size_t num_threads) {
+    outputs.resize(inputs.size());
+    simplify_batch(inputs.data(), outputs.data(), inputs.size(),
+                   tolerance, algorithm, num_threads);
+}
+
+} // namespace geom
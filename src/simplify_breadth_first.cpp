@@ -0,0 +1,101 @@
+#include "geom_simd/internal/simplify_internal.h"
+#include <algorithm>
+#include <utility>
+
+namespace geom {
+namespace internal {
+
+namespace {
+
+// Ranges up to this many points are finished level by level; larger ones are
+// split depth-first first. Keeps each level sweep inside L2 instead of
+// streaming the whole line once per level.
+constexpr size_t kLevelBlockPoints = 16384;
+
+} // anonymous namespace
+
+void simplify_breadth_first(const PolylineSoA& input,
+                            double tolerance,
+                            SimplifyScratch& scratch,
+                            SweepLevelFn sweep_level) {
+    double tolerance_sq = tolerance * tolerance;
+
+    size_t n = input.size();
+    scratch.keep.assign(keep_words(n), 0);
+    set_keep(scratch.keep, 0);  // Always keep first point
+    set_keep(scratch.keep, n - 1);  // Always keep last point
+
+    // All of these only grow, so a warmed-up scratch sweeps without allocating
+    std::vector<Segment>& blocks = scratch.blocks;
+    std::vector<Segment>& level = scratch.level;
+    std::vector<Segment>& next = scratch.next_level;
+    std::vector<FarthestPoint>& far = scratch.farthest;
+
+    // Sized here because the sweeps are built with ISA flags and must not
+    // instantiate any std::vector code. A level never holds more interior
+    // points than the block it came from, nor more than one range per two
+    // of its points; a big range swept alone packs nothing.
+    size_t block = std::min(n, kLevelBlockPoints);
+    if (scratch.lane_key.size() < block + 8) {
+        scratch.lane_key.resize(block + 8);
+        scratch.lane_point.resize(block + 8);
+        scratch.lane_slot.resize(block + 8);
+    }
+    if (scratch.slot_last.size() < block / 2 + 1) {
+        scratch.slot_last.resize(block / 2 + 1);
+        scratch.slot_segment.resize(block / 2 + 1);
+    }
+    const PackedLanes lanes = {scratch.lane_key.data(), scratch.lane_point.data(),
+                               scratch.lane_slot.data(), scratch.slot_last.data(),
+                               scratch.slot_segment.data()};
+
+    // Every level is kept in point order, which the packed sweeps rely on
+    auto split = [&](Segment seg, const FarthestPoint& f, std::vector<Segment>& out) {
+        if (f.dist_sq <= tolerance_sq) {
+            return;
+        }
+        set_keep(scratch.keep, f.index);
+        if (f.index > seg.start + 1) {
+            out.push_back({seg.start, f.index});
+        }
+        if (seg.end > f.index + 1) {
+            out.push_back({f.index, seg.end});
+        }
+    };
+
+    blocks.clear();
+    blocks.push_back({0, n - 1});
+    while (!blocks.empty()) {
+        Segment root = blocks.back();
+        blocks.pop_back();
+
+        // Big ranges fill the vectors on their own, split them one at a time
+        if (root.end - root.start >= kLevelBlockPoints) {
+            FarthestPoint f;
+            sweep_level(input, &root, 1, &f, lanes);
+            size_t before = blocks.size();
+            split(root, f, blocks);
+            // Right half is popped last, same visiting order as the serial driver
+            if (blocks.size() - before == 2) {
+                std::swap(blocks[before], blocks[before + 1]);
+            }
+            continue;
+        }
+
+        level.clear();
+        level.push_back(root);
+        while (!level.empty()) {
+            far.resize(level.size());
+            sweep_level(input, level.data(), level.size(), far.data(), lanes);
+
+            next.clear();
+            for (size_t j = 0; j < level.size(); ++j) {
+                split(level[j], far[j], next);
+            }
+            std::swap(level, next);
+        }
+    }
+}
+
+} // namespace internal
+} // namespace geom
@@ -0,0 +1,98 @@
+#include "geom_simd/internal/simplify_internal.h"
+#include "geom_simd/internal/thread_pool.h"
+#include <atomic>
+
+namespace geom {
+namespace internal {
+
+namespace {
+
+struct ParallelContext {
+    const PolylineSoA& points;
+    double tolerance_sq;
+    uint64_t* keep;
+    FindFarthestFn find_farthest;
+    size_t threshold;
+    ThreadPool& pool;
+    TaskGroup& group;
+    // Tasks queued or running; forking stops at max_tasks so the call never
+    // uses more than num_threads of the shared pool's threads
+    std::atomic<size_t> tasks;
+    size_t max_tasks;
+};
+
+// Neighbouring tasks can own points in the same 64-bit word
+inline void set_keep_atomic(uint64_t* keep, size_t i) {
+    __atomic_fetch_or(&keep[i >> 6], uint64_t{1} << (i & 63), __ATOMIC_RELAXED);
+}
+
+// Take one of the call's task slots, if any is free. A big range that
+// doesn't get one is still split when popped, so its halves get another
+// chance to fork once some task has finished.
+bool claim_task(ParallelContext& ctx) {
+    size_t tasks = ctx.tasks.load(std::memory_order_relaxed);
+    while (tasks < ctx.max_tasks) {
+        if (ctx.tasks.compare_exchange_weak(tasks, tasks + 1, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void process_range(ParallelContext& ctx, Segment root) {
+    std::vector<Segment> stack;
+    stack.push_back(root);
+
+    auto schedule = [&](Segment seg) {
+        if (seg.end <= seg.start + 1) {
+            return;
+        }
+        if (seg.end - seg.start >= ctx.threshold && claim_task(ctx)) {
+            ctx.pool.submit(ctx.group, [&ctx, seg] { process_range(ctx, seg); });
+        } else {
+            stack.push_back(seg);
+        }
+    };
+
+    while (!stack.empty()) {
+        Segment seg = stack.back();
+        stack.pop_back();
+
+        FarthestPoint far = ctx.find_farthest(ctx.points, seg.start, seg.end);
+        if (far.dist_sq <= ctx.tolerance_sq) {
+            continue;
+        }
+
+        set_keep_atomic(ctx.keep, far.index);
+        schedule({far.index, seg.end});
+        schedule({seg.start, far.index});
+    }
+
+    ctx.tasks.fetch_sub(1, std::memory_order_relaxed);
+}
+
+} // anonymous namespace
+
+void simplify_parallel(const PolylineSoA& input,
+                       double tolerance,
+                       SimplifyScratch& scratch,
+                       FindFarthestFn find_farthest,
+                       size_t num_threads,
+                       size_t threshold) {
+    size_t n = input.size();
+    scratch.keep.assign(keep_words(n), 0);
+    set_keep(scratch.keep, 0);  // Always keep first point
+    set_keep(scratch.keep, n - 1);  // Always keep last point
+
+    ThreadPool& pool = shared_thread_pool();
+    TaskGroup group;
+    ParallelContext ctx{input, tolerance * tolerance, scratch.keep.data(),
+                        find_farthest, threshold < 3 ? 3 : threshold, pool, group,
+                        {1}, clamp_threads(num_threads)};
+
+    pool.submit(group, [&ctx, n] { process_range(ctx, {0, n - 1}); });
+    pool.wait(group);
+}
+
+} // namespace internal
+} // namespace geom
@@ -1,87 +1,189 @@
 #include "geom_simd/internal/simplify_internal.h"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace geom {
 namespace internal {
 
-namespace {
-
-/**
- * Recursive Douglas-Peucker implementation.
- * 
- * @param points Input points
- * @param start Start index (inclusive)
- * @param end End index (inclusive)
- * @param tolerance Squared tolerance threshold
- * @param keep Bitmask of which points to keep
- */
-void douglas_peucker_recursive(const PolylineSoA& points,
-                               size_t start,
-                               size_t end,
-                               double tolerance_sq,
-                               std::vector<bool>& keep) {
-    if (end <= start + 1) {
-        return;
+FarthestPoint find_farthest_scalar(const PolylineSoA& points,
+                                   size_t start,
+                                   size_t end) {
+    // Rank on the squared cross product and divide once at the end, like
+    // the SIMD kernels: comparing divided quotients can round two points to
+    // the same distance and pick a different argmax than the other ISAs
+    double x1 = points.x[start];
+    double y1 = points.y[start];
+    double seg_dx = points.x[end] - x1;
+    double seg_dy = points.y[end] - y1;
+    double seg_mag_sq = seg_dx * seg_dx + seg_dy * seg_dy;
+    const bool degenerate = seg_mag_sq < 1e-10;
+
+    double max_key = 0.0;
+    size_t max_idx = start;
+
+    for (size_t i = start + 1; i < end; ++i) {
+        double dpx = points.x[i] - x1;
+        double dpy = points.y[i] - y1;
+        double key;
+        if (degenerate) {
+            key = dpx * dpx + dpy * dpy;
+        } else {
+            double cross = dpx * seg_dy - dpy * seg_dx;
+            key = cross * cross;
+        }
+
+        if (key > max_key) {
+            max_key = key;
+            max_idx = i;
+        }
     }
-    
-    auto p_start = points[start];
-    auto p_end = points[end];
-    
-    // Find the point with maximum distance
-    double max_dist_sq = 0.0;
+
+    double max_dist_sq = degenerate ? max_key : max_key / seg_mag_sq;
+    return {max_dist_sq, max_idx};
+}
+
+FarthestPoint find_farthest_scalar_f32(const PolylineSoAf& points,
+                                       size_t start,
+                                       size_t end) {
+    // Same operations as the float SIMD kernels, in the same order, so every
+    // ISA agrees on the argmax
+    float x1 = points.x[start];
+    float y1 = points.y[start];
+    float seg_dx = points.x[end] - x1;
+    float seg_dy = points.y[end] - y1;
+    float seg_mag_sq = seg_dx * seg_dx + seg_dy * seg_dy;
+    const bool degenerate = seg_mag_sq < 1e-10f;
+
+    float max_key = 0.0f;
     size_t max_idx = start;
-    
+
     for (size_t i = start + 1; i < end; ++i) {
-        double dist_sq = perpendicular_distance(
-            points[i].x, points[i].y,
-            p_start.x, p_start.y,
-            p_end.x, p_end.y
-        );
-        
-        if (dist_sq > max_dist_sq) {
-            max_dist_sq = dist_sq;
+        float dpx = points.x[i] - x1;
+        float dpy = points.y[i] - y1;
+        float key;
+        if (degenerate) {
+            key = dpx * dpx + dpy * dpy;
+        } else {
+            float cross = dpx * seg_dy - dpy * seg_dx;
+            key = cross * cross;
+        }
+
+        if (key > max_key) {
+            max_key = key;
             max_idx = i;
         }
     }
-    
-    // If max distance exceeds tolerance, keep the point and recurse
-    if (max_dist_sq > tolerance_sq) {
-        keep[max_idx] = true;
-        douglas_peucker_recursive(points, start, max_idx, tolerance_sq, keep);
-        douglas_peucker_recursive(points, max_idx, end, tolerance_sq, keep);
+
+    float max_dist_sq = degenerate ? max_key : max_key / seg_mag_sq;
+    return {max_dist_sq, max_idx};
+}
+
+FarthestPoint find_farthest_scalar_i32(const PolylineSoAi& points,
+                                       size_t start,
+                                       size_t end) {
+    int64_t x1 = points.x[start];
+    int64_t y1 = points.y[start];
+    int64_t seg_dx = points.x[end] - x1;
+    int64_t seg_dy = points.y[end] - y1;
+    int64_t chord_sq = seg_dx * seg_dx + seg_dy * seg_dy;
+
+    // |cross| ranks points the same as cross^2 / |chord|^2 and can't overflow
+    int64_t max_key = 0;
+    size_t max_idx = start;
+
+    for (size_t i = start + 1; i < end; ++i) {
+        int64_t dpx = points.x[i] - x1;
+        int64_t dpy = points.y[i] - y1;
+        int64_t key;
+        if (chord_sq == 0) {
+            key = dpx * dpx + dpy * dpy;
+        } else {
+            int64_t cross = dpx * seg_dy - dpy * seg_dx;
+            key = cross < 0 ? -cross : cross;
+        }
+
+        if (key > max_key) {
+            max_key = key;
+            max_idx = i;
+        }
+    }
+
+    return {fixed_point_dist_sq(max_key, chord_sq), max_idx};
+}
+
+void simplify_scalar(const PolylineSoA& input, double tolerance, SimplifyScratch& scratch) {
+    simplify_with(input, tolerance, scratch, find_farthest_scalar);
+}
+
+void simplify_serial(const PolylineSoA& input,
+                     double tolerance,
+                     SimplifyScratch& scratch,
+                     FindFarthestFn find_farthest) {
+    simplify_with(input, tolerance, scratch, find_farthest);
+}
+
+size_t filter_significant_scalar(const double* x, const double* y, const double* significance,
+                                 size_t n, double threshold, double* out_x, double* out_y) {
+    // Branch-free: always write, only advance on a hit
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        out_x[count] = x[i];
+        out_y[count] = y[i];
+        count += significance[i] > threshold ? 1 : 0;
     }
+    return count;
 }
 
-} // anonymous namespace
+void sweep_level_scalar(const PolylineSoA& points, const Segment* segs, size_t count,
+                        FarthestPoint* out, const PackedLanes&) {
+    sweep_level_with(points, segs, count, out, find_farthest_scalar);
+}
 
-PolylineSoA simplify_scalar(const PolylineSoA& input, double tolerance) {
-    if (input.size() <= 2) {
-        return input;
+void triangle_areas_scalar(const double* x, const double* y, size_t n, double* areas) {
+    areas[0] = std::numeric_limits<double>::infinity();
+    for (size_t i = 1; i + 1 < n; ++i) {
+        areas[i] = triangle_area(x[i - 1], y[i - 1], x[i], y[i], x[i + 1], y[i + 1]);
     }
-    
-    // Square the tolerance to avoid sqrt in distance calculations
-    double tolerance_sq = tolerance * tolerance;
-    
-    // Mark which points to keep
-    std::vector<bool> keep(input.size(), false);
-    keep[0] = true;  // Always keep first point
-    keep[input.size() - 1] = true;  // Always keep last point
-    
-    // Run the recursive algorithm
-    douglas_peucker_recursive(input, 0, input.size() - 1, tolerance_sq, keep);
-    
-    // Build the result
-    PolylineSoA result;
-    result.reserve(input.size());  // Upper bound
-    
-    for (size_t i = 0; i < input.size(); ++i) {
-        if (keep[i]) {
-            result.push_back(input[i].x, input[i].y);
+    areas[n - 1] = std::numeric_limits<double>::infinity();
+}
+
+size_t find_exit_scalar(const double* x, const double* y, size_t n,
+                        double kx, double ky, double dx, double dy, double limit) {
+    for (size_t i = 0; i < n; ++i) {
+        if (strip_cross_sq(x[i], y[i], kx, ky, dx, dy) > limit) {
+            return i;
         }
     }
-    
-    return result;
+    return n;
+}
+
+size_t radial_filter_scalar(const double* x, const double* y, size_t n,
+                            double tolerance_sq, double* out_x, double* out_y) {
+    out_x[0] = x[0];
+    out_y[0] = y[0];
+    size_t count = 1;
+    size_t key = 0;
+
+    for (size_t i = 1; i < n; ++i) {
+        double dx = x[i] - x[key];
+        double dy = y[i] - y[key];
+        if (dx * dx + dy * dy > tolerance_sq) {
+            out_x[count] = x[i];
+            out_y[count] = y[i];
+            ++count;
+            key = i;
+        }
+    }
+
+    // The last point is always kept, however close it is
+    if (key != n - 1) {
+        out_x[count] = x[n - 1];
+        out_y[count] = y[n - 1];
+        ++count;
+    }
+
+    return count;
 }
 
 } // namespace internal
@@ -0,0 +1,93 @@
+#include "geom_simd/geom_simd.h"
+#include "geom_simd/internal/simplify_internal.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace geom {
+
+std::vector<double> simplify_significance(const PolylineSoA& input,
+                                          SimplifyAlgorithm algorithm) {
+    size_t n = input.size();
+    std::vector<double> significance(n, 0.0);
+    if (n == 0) {
+        return significance;
+    }
+
+    // Endpoints survive every tolerance
+    significance[0] = std::numeric_limits<double>::infinity();
+    significance[n - 1] = std::numeric_limits<double>::infinity();
+    if (n <= 2) {
+        return significance;
+    }
+
+    internal::FindFarthestFn find_farthest = internal::select_backend(algorithm, n).find_farthest;
+
+    // Douglas-Peucker with zero tolerance. The split chosen for a range
+    // doesn't depend on the tolerance, so this builds the same split tree
+    // every tolerance walks, just all the way down.
+    std::vector<internal::Segment> stack;
+    stack.push_back({0, n - 1});
+
+    while (!stack.empty()) {
+        internal::Segment seg = stack.back();
+        stack.pop_back();
+
+        internal::FarthestPoint far = find_farthest(input, seg.start, seg.end);
+        if (far.dist_sq <= 0.0) {
+            continue;
+        }
+
+        // The range's bounds are its parent split and an older ancestor (or
+        // an endpoint), so the smaller of the two is the parent's
+        // significance. Clamping to it keeps significance monotone down the
+        // tree: a vertex can't survive a tolerance its parent doesn't.
+        double parent = std::min(significance[seg.start], significance[seg.end]);
+        significance[far.index] = std::min(far.dist_sq, parent);
+
+        if (seg.end > far.index + 1) {
+            stack.push_back({far.index, seg.end});
+        }
+        if (far.index > seg.start + 1) {
+            stack.push_back({seg.start, far.index});
+        }
+    }
+
+    return significance;
+}
+
+void simplify_by_significance(const PolylineSoA& input,
+                              const std::vector<double>& significance,
+                              double tolerance,
+                              PolylineSoA& output,
+                              SimplifyAlgorithm algorithm) {
+    if (significance.size() != input.size()) {
+        throw std::invalid_argument("Significance must have one entry per input point");
+    }
+
+    // Same early exit as simplify(): short lines come back unchanged
+    if (input.size() <= 2) {
+        output.x.assign(input.x.begin(), input.x.end());
+        output.y.assign(input.y.begin(), input.y.end());
+        return;
+    }
+
+    if (tolerance <= 0.0) {
+        throw std::invalid_argument("Tolerance must be positive");
+    }
+
+    internal::FilterSignificantFn filter =
+        internal::select_backend(algorithm, input.size()).filter_significant;
+
+    // Size for the worst case, the kernels store whole vectors
+    output.x.resize(input.size());
+    output.y.resize(input.size());
+
+    size_t count = filter(input.x.data(), input.y.data(), significance.data(), input.size(),
+                          tolerance * tolerance, output.x.data(), output.y.data());
+
+    output.x.resize(count);
+    output.y.resize(count);
+}
+
+} // namespace geom
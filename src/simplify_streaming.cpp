@@ -0,0 +1,116 @@
+#include "geom_simd/streaming.h"
+#include "geom_simd/internal/simplify_internal.h"
+#include <stdexcept>
+
+namespace geom {
+
+StreamingSimplifier::StreamingSimplifier(double tolerance, SimplifyAlgorithm algorithm)
+    : tolerance_(tolerance),
+      tolerance_sq_(tolerance * tolerance),
+      algorithm_(algorithm) {
+    if (tolerance <= 0.0) {
+        throw std::invalid_argument("Tolerance must be positive");
+    }
+
+    // Fail here rather than on the first push_many() if the ISA is missing
+    internal::select_backend(algorithm, 0);
+}
+
+void StreamingSimplifier::rekey(double x, double y) {
+    key_x_ = last_x_;
+    key_y_ = last_y_;
+    dir_x_ = x - key_x_;
+    dir_y_ = y - key_y_;
+    limit_ = tolerance_sq_ * (dir_x_ * dir_x_ + dir_y_ * dir_y_);
+    last_x_ = x;
+    last_y_ = y;
+}
+
+size_t StreamingSimplifier::push(double x, double y, PolylineSoA& output) {
+    // First point of a trace is always kept
+    if (!has_key_) {
+        key_x_ = x;
+        key_y_ = y;
+        has_key_ = true;
+        output.push_back(x, y);
+        return 1;
+    }
+
+    // First point after the key aims the strip. Repeats of the key can't,
+    // and would be dropped by any strip anyway.
+    if (!has_dir_) {
+        if (x == key_x_ && y == key_y_) {
+            return 0;
+        }
+        last_x_ = key_x_;
+        last_y_ = key_y_;
+        rekey(x, y);
+        has_dir_ = true;
+        has_last_ = true;
+        return 0;
+    }
+
+    // Compare cross^2 against tolerance^2 * |dir|^2, no division per point
+    if (internal::strip_cross_sq(x, y, key_x_, key_y_, dir_x_, dir_y_) <= limit_) {
+        last_x_ = x;
+        last_y_ = y;
+        return 0;
+    }
+
+    // Left the strip: the previous point is final and starts the next strip
+    output.push_back(last_x_, last_y_);
+    rekey(x, y);
+    return 1;
+}
+
+size_t StreamingSimplifier::push_many(const double* x, const double* y, size_t count,
+                                      PolylineSoA& output) {
+    size_t emitted = 0;
+    size_t i = 0;
+
+    // Until the strip has a direction there's nothing to scan against
+    for (; i < count && !has_dir_; ++i) {
+        emitted += push(x[i], y[i], output);
+    }
+    if (i == count) {
+        return emitted;
+    }
+
+    internal::FindExitFn find_exit = internal::select_backend(algorithm_, count - i).find_exit;
+
+    while (i < count) {
+        size_t exit = i + find_exit(&x[i], &y[i], count - i,
+                                    key_x_, key_y_, dir_x_, dir_y_, limit_);
+        if (exit == count) {
+            last_x_ = x[count - 1];
+            last_y_ = y[count - 1];
+            break;
+        }
+
+        if (exit > i) {
+            last_x_ = x[exit - 1];
+            last_y_ = y[exit - 1];
+        }
+        output.push_back(last_x_, last_y_);
+        ++emitted;
+        rekey(x[exit], y[exit]);
+        i = exit + 1;
+    }
+
+    return emitted;
+}
+
+size_t StreamingSimplifier::flush(PolylineSoA& output) {
+    size_t emitted = 0;
+    if (has_last_) {
+        output.push_back(last_x_, last_y_);
+        emitted = 1;
+    }
+
+    has_key_ = false;
+    has_dir_ = false;
+    has_last_ = false;
+    return emitted;
+}
+
+} // namespace geom
@@ -0,0 +1,231 @@
+#include "geom_simd/geom_simd.h"
+#include "geom_simd/internal/simplify_internal.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace geom {
+
+namespace {
+
+/**
+ * Indexed 4-ary min-heap of (area, vertex) pairs.
+ *
+ * A 4-ary layout halves the depth of a binary heap and keeps a node's four
+ * children within 64 bytes, which matters more than the extra compares since
+ * every removal re-keys two neighbours. pos_ maps a vertex to its slot so
+ * those re-keys are O(log n) instead of a lazy-deletion push.
+ *
+ * Only vertices below the tolerance are queued: the order among the rest
+ * never matters, since the first of them to reach the top ends the run.
+ */
+class AreaHeap {
+public:
+    static constexpr size_t kNone = static_cast<size_t>(-1);
+
+    struct Entry {
+        double area;
+        size_t vertex;
+    };
+
+    /// Heapify the given vertices in O(n); pos_ is sized for n vertices
+    void build(size_t n, std::vector<Entry> entries) {
+        entries_ = std::move(entries);
+        pos_.assign(n, kNone);
+        for (size_t slot = 0; slot < entries_.size(); ++slot) {
+            pos_[entries_[slot].vertex] = slot;
+        }
+
+        if (entries_.size() > 1) {
+            for (size_t slot = (entries_.size() - 2) / 4 + 1; slot-- > 0;) {
+                sift_down(slot);
+            }
+        }
+    }
+
+    bool empty() const { return entries_.empty(); }
+    const Entry& top() const { return entries_.front(); }
+
+    bool contains(size_t vertex) const { return pos_[vertex] != kNone; }
+
+    void push(size_t vertex, double area) {
+        entries_.push_back({area, vertex});
+        sift_up(entries_.size() - 1);
+    }
+
+    void pop() { erase(entries_.front().vertex); }
+
+    void erase(size_t vertex) {
+        size_t slot = pos_[vertex];
+        pos_[vertex] = kNone;
+        Entry last = entries_.back();
+        entries_.pop_back();
+        if (slot < entries_.size()) {
+            Entry old = entries_[slot];
+            place(slot, last);
+            restore(slot, old);
+        }
+    }
+
+    /// Change a queued vertex's area, moving it whichever way it needs to go
+    void update(size_t vertex, double area) {
+        size_t slot = pos_[vertex];
+        Entry old = entries_[slot];
+        entries_[slot].area = area;
+        restore(slot, old);
+    }
+
+private:
+    // Ties go to the lower vertex so every back end removes in the same order
+    static bool less(const Entry& a, const Entry& b) {
+        return a.area < b.area || (a.area == b.area && a.vertex < b.vertex);
+    }
+
+    // Compare with less() rather than the bare area: an entry that ties on
+    // area but now sorts below its old place still has to move up
+    void restore(size_t slot, const Entry& old) {
+        if (less(entries_[slot], old)) {
+            sift_up(slot);
+        } else {
+            sift_down(slot);
+        }
+    }
+
+    void place(size_t slot, const Entry& entry) {
+        entries_[slot] = entry;
+        pos_[entry.vertex] = slot;
+    }
+
+    void sift_up(size_t slot) {
+        Entry entry = entries_[slot];
+        while (slot > 0) {
+            size_t parent = (slot - 1) / 4;
+            if (!less(entry, entries_[parent])) {
+                break;
+            }
+            place(slot, entries_[parent]);
+            slot = parent;
+        }
+        place(slot, entry);
+    }
+
+    void sift_down(size_t slot) {
+        Entry entry = entries_[slot];
+        size_t size = entries_.size();
+        for (;;) {
+            size_t first = slot * 4 + 1;
+            if (first >= size) {
+                break;
+            }
+            size_t last = std::min(first + 4, size);
+            size_t best = first;
+            for (size_t child = first + 1; child < last; ++child) {
+                if (less(entries_[child], entries_[best])) {
+                    best = child;
+                }
+            }
+            if (!less(entries_[best], entry)) {
+                break;
+            }
+            place(slot, entries_[best]);
+            slot = best;
+        }
+        place(slot, entry);
+    }
+
+    std::vector<Entry> entries_;
+    std::vector<size_t> pos_;
+};
+
+} // anonymous namespace
+
+PolylineSoA simplify_vw(const PolylineSoA& input,
+                        double area_tolerance,
+                        SimplifyAlgorithm algorithm) {
+    size_t n = input.size();
+    if (n <= 2) {
+        return input;  // Can't simplify lines with 2 or fewer points
+    }
+
+    if (area_tolerance <= 0.0) {
+        throw std::invalid_argument("Tolerance must be positive");
+    }
+
+    internal::TriangleAreasFn triangle_areas = internal::select_backend(algorithm, n).triangle_areas;
+
+    const double* x = input.x.data();
+    const double* y = input.y.data();
+
+    // Initial areas are the only part that touches every point, so they go
+    // to the SIMD kernel; the removal loop below only visits removed points
+    // and their neighbours
+    std::vector<double> areas(n);
+    triangle_areas(x, y, n, areas.data());
+
+    // Doubly linked list over the surviving vertices
+    std::vector<size_t> prev(n), next(n);
+    for (size_t i = 0; i < n; ++i) {
+        prev[i] = i - 1;
+        next[i] = i + 1;
+    }
+
+    std::vector<AreaHeap::Entry> candidates;
+    for (size_t i = 1; i + 1 < n; ++i) {
+        if (areas[i] < area_tolerance) {
+            candidates.push_back({areas[i], i});
+        }
+    }
+
+    AreaHeap heap;
+    heap.build(n, std::move(candidates));
+
+    // Re-key a neighbour against its new triangle. Clamping to the removed
+    // area keeps effective areas non-decreasing in removal order, so a
+    // vertex is never dropped before one it outlived.
+    auto rekey = [&](size_t vertex, double area, double removed_area) {
+        area = std::max(area, removed_area);
+        if (area < area_tolerance) {
+            if (heap.contains(vertex)) {
+                heap.update(vertex, area);
+            } else {
+                heap.push(vertex, area);
+            }
+        } else if (heap.contains(vertex)) {
+            heap.erase(vertex);
+        }
+    };
+
+    size_t removed = 0;
+    while (!heap.empty()) {
+        AreaHeap::Entry entry = heap.top();
+        heap.pop();
+
+        size_t p = prev[entry.vertex];
+        size_t q = next[entry.vertex];
+        next[p] = q;
+        prev[q] = p;
+        ++removed;
+
+        if (p != 0) {
+            size_t pp = prev[p];
+            rekey(p, internal::triangle_area(x[pp], y[pp], x[p], y[p], x[q], y[q]), entry.area);
+        }
+        if (q != n - 1) {
+            size_t qq = next[q];
+            rekey(q, internal::triangle_area(x[p], y[p], x[q], y[q], x[qq], y[qq]), entry.area);
+        }
+    }
+
+    PolylineSoA output;
+    output.x.resize(n - removed);
+    output.y.resize(n - removed);
+    size_t kept = 0;
+    for (size_t i = 0; i < n; i = next[i], ++kept) {
+        output.x[kept] = x[i];
+        output.y[kept] = y[i];
+    }
+
+    return output;
+}
+
+} // namespace geom
@@ -0,0 +1,174 @@
+#include "geom_simd/internal/thread_pool.h"
+#include <algorithm>
+
+namespace geom {
+namespace internal {
+
+namespace {
+
+// Which pool (if any) the current thread works for, and its queue index
+thread_local ThreadPool* tl_pool = nullptr;
+thread_local size_t tl_index = 0;
+
+} // anonymous namespace
+
+ThreadPool::ThreadPool(size_t concurrency) {
+    if (concurrency == 0) {
+        concurrency = 1;
+    }
+
+    for (size_t i = 0; i < concurrency; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+
+    workers_.reserve(concurrency - 1);
+    for (size_t i = 0; i + 1 < concurrency; ++i) {
+        workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(TaskGroup& group, Task task) {
+    group.pending_.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        // Count the task before it becomes visible so a thief can never
+        // decrement past zero, and do it under the sleep mutex so a worker
+        // can't miss the wakeup between checking queued_ and sleeping
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        queued_.fetch_add(1, std::memory_order_release);
+    }
+
+    size_t index = (tl_pool == this) ? tl_index : queues_.size() - 1;
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.emplace_back(&group, std::move(task));
+    }
+    wake_.notify_one();
+}
+
+void ThreadPool::wait(TaskGroup& group) {
+    // Outside callers share the injector slot as their home queue
+    size_t home = (tl_pool == this) ? tl_index : queues_.size() - 1;
+
+    while (group.pending_.load(std::memory_order_acquire) != 0) {
+        if (try_run_one(home)) {
+            continue;
+        }
+
+        // Nothing left to run or steal: the group's last tasks are running
+        // elsewhere, so sleep until one of them finishes or more work shows up
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [&] {
+            return group.pending_.load(std::memory_order_acquire) == 0 ||
+                   queued_.load(std::memory_order_acquire) != 0;
+        });
+    }
+
+    if (group.error_) {
+        std::exception_ptr error = group.error_;
+        group.error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::worker_loop(size_t index) {
+    tl_pool = this;
+    tl_index = index;
+
+    for (;;) {
+        if (try_run_one(index)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [this] {
+            return stop_ || queued_.load(std::memory_order_acquire) != 0;
+        });
+        if (stop_) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::try_run_one(size_t home) {
+    std::pair<TaskGroup*, Task> item;
+    if (pop_local(home, item) || steal(home, item)) {
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        run(item);
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::pop_local(size_t index, std::pair<TaskGroup*, Task>& out) {
+    Queue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    out = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(size_t thief, std::pair<TaskGroup*, Task>& out) {
+    size_t n = queues_.size();
+    for (size_t k = 1; k < n; ++k) {
+        Queue& queue = *queues_[(thief + k) % n];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            out = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(std::pair<TaskGroup*, Task>& item) {
+    TaskGroup& group = *item.first;
+    try {
+        item.second();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(group.error_mutex_);
+        if (!group.error_) {
+            group.error_ = std::current_exception();
+        }
+    }
+    // Drop the task's captures before the waiter can return and unwind
+    // whatever they point at
+    item.second = nullptr;
+    if (group.pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // The waiter may return and destroy the group as soon as it sees
+        // zero, so only pool state is touched from here. Taking the mutex
+        // orders this against a waiter between its check and its sleep.
+        { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+        wake_.notify_all();
+    }
+}
+
+ThreadPool& shared_thread_pool() {
+    // Magic static: thread-safe construction, joined at exit
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+    return pool;
+}
+
+size_t clamp_threads(size_t num_threads) {
+    size_t available = shared_thread_pool().concurrency();
+    return (num_threads == 0 || num_threads > available) ? available : num_threads;
+}
+
+} // namespace internal
+} // namespace geom
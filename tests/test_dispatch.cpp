@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include "geom_simd/geom_simd.h"
+#include "geom_simd/clip.h"
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace geom;
+
+namespace {
+
+// Puts the profile back however a test exits
+class DispatchTest : public ::testing::Test {
+protected:
+    void SetUp() override { saved_ = get_dispatch_profile(); }
+    void TearDown() override { set_dispatch_profile(saved_); }
+
+    static std::string temp_path(const char* name) {
+        return ::testing::TempDir() + name;
+    }
+
+private:
+    DispatchProfile saved_;
+};
+
+PolylineSoA create_wander(size_t n, unsigned seed) {
+    unsigned state = seed;
+    PolylineSoA line;
+    double y = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        state = state * 1664525u + 1013904223u;
+        y += static_cast<double>(state >> 8) / static_cast<double>(1u << 24) - 0.5;
+        line.push_back(static_cast<double>(i), y);
+    }
+    return line;
+}
+
+void expect_same_line(const PolylineSoA& a, const PolylineSoA& b) {
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        EXPECT_EQ(a.x[i], b.x[i]);
+        EXPECT_EQ(a.y[i], b.y[i]);
+    }
+}
+
+} // anonymous namespace
+
+TEST_F(DispatchTest, DefaultsKeepWidestIsaAndSerial) {
+    DispatchProfile profile;
+    EXPECT_EQ(profile.avx2_min_points, 0u);
+    EXPECT_EQ(profile.avx512_min_points, 0u);
+    EXPECT_EQ(profile.neon_min_points, 0u);
+    EXPECT_EQ(profile.sse2_min_points, 0u);
+    EXPECT_EQ(profile.parallel_min_points, SIZE_MAX);
+    EXPECT_EQ(profile.intersect_simd_min_edges, 0u);
+}
+
+TEST_F(DispatchTest, SetAndGet) {
+    DispatchProfile profile;
+    profile.avx2_min_points = 12;
+    profile.avx512_min_points = 345;
+    profile.parallel_min_points = 1 << 20;
+    profile.intersect_simd_min_edges = 6;
+    set_dispatch_profile(profile);
+
+    DispatchProfile current = get_dispatch_profile();
+    EXPECT_EQ(current.avx2_min_points, 12u);
+    EXPECT_EQ(current.avx512_min_points, 345u);
+    EXPECT_EQ(current.neon_min_points, 0u);
+    EXPECT_EQ(current.parallel_min_points, size_t{1} << 20);
+    EXPECT_EQ(current.intersect_simd_min_edges, 6u);
+}
+
+TEST_F(DispatchTest, SaveAndLoadRoundTrip) {
+    DispatchProfile profile;
+    profile.avx2_min_points = 7;
+    profile.avx512_min_points = SIZE_MAX;
+    profile.neon_min_points = 9;
+    profile.sse2_min_points = 3;
+    profile.parallel_min_points = 262144;
+    profile.intersect_simd_min_edges = 16;
+
+    std::string path = temp_path("geom_simd_profile_roundtrip.txt");
+    save_dispatch_profile(profile, path);
+    DispatchProfile loaded = load_dispatch_profile(path);
+
+    EXPECT_EQ(loaded.avx2_min_points, 7u);
+    EXPECT_EQ(loaded.avx512_min_points, SIZE_MAX);
+    EXPECT_EQ(loaded.neon_min_points, 9u);
+    EXPECT_EQ(loaded.sse2_min_points, 3u);
+    EXPECT_EQ(loaded.parallel_min_points, 262144u);
+    EXPECT_EQ(loaded.intersect_simd_min_edges, 16u);
+}
+
+TEST_F(DispatchTest, LoadSkipsCommentsAndUnknownNames) {
+    std::string path = temp_path("geom_simd_profile_partial.txt");
+    {
+        std::ofstream out(path);
+        out << "# hand written\n\navx512_min_points 100\nsome_future_field 3\n";
+    }
+
+    DispatchProfile loaded = load_dispatch_profile(path);
+    EXPECT_EQ(loaded.avx512_min_points, 100u);
+    EXPECT_EQ(loaded.avx2_min_points, 0u);  // Missing, keeps its default
+    EXPECT_EQ(loaded.parallel_min_points, SIZE_MAX);
+}
+
+TEST_F(DispatchTest, LoadRejectsBadFiles) {
+    EXPECT_THROW(load_dispatch_profile(temp_path("geom_simd_profile_missing.txt")),
+                 std::runtime_error);
+
+    const char* bad_lines[] = {
+        "avx2_min_points\n",
+        "avx2_min_points -4\n",
+        "avx2_min_points 12abc\n",
+        "avx2_min_points 12 34\n",
+        "avx2_min_points 99999999999999999999999\n",
+    };
+    for (const char* line : bad_lines) {
+        std::string path = temp_path("geom_simd_profile_bad.txt");
+        {
+            std::ofstream out(path);
+            out << line;
+        }
+        EXPECT_THROW(load_dispatch_profile(path), std::runtime_error) << line;
+    }
+}
+
+TEST_F(DispatchTest, AutoMatchesScalarAtEveryCrossover) {
+    // Thresholds inside the size range, so AUTO switches ISA and execution
+    // mode partway through
+    DispatchProfile profile;
+    profile.avx2_min_points = 8;
+    profile.neon_min_points = 8;
+    profile.avx512_min_points = 64;
+    profile.parallel_min_points = 2000;
+    set_dispatch_profile(profile);
+
+    SimplifyOptions options;
+    options.execution = SimplifyExecution::AUTO;
+    options.parallel_threshold = 256;
+
+    for (size_t n : {3u, 5u, 8u, 9u, 63u, 64u, 65u, 500u, 1999u, 2000u, 5000u}) {
+        PolylineSoA line = create_wander(n, static_cast<unsigned>(n));
+        PolylineSoA expected = simplify(line, 0.3, SimplifyAlgorithm::SCALAR);
+
+        expect_same_line(simplify(line, 0.3, options), expected);
+        expect_same_line(simplify(line, 0.3), expected);
+    }
+}
+
+TEST_F(DispatchTest, IntersectRangeMatchesScalarAcrossCrossover) {
+    DispatchProfile profile;
+    profile.intersect_simd_min_edges = 8;
+    set_dispatch_profile(profile);
+
+    // Every other vertex on edge A, up to rounding, so B's edges touch A
+    // at an endpoint and an ISA that rounds differently would flip them
+    PolylineSoA wander = create_wander(40, 7);
+    Point a1(0.0, 0.3), a2(39.0, 7.1);
+    PolylineSoA edges;
+    for (size_t j = 0; j < wander.size(); ++j) {
+        double s = wander.x[j] / 39.0;
+        if (j % 2 == 0) {
+            edges.push_back(a1.x + s * (a2.x - a1.x), a1.y + s * (a2.y - a1.y));
+        } else {
+            edges.push_back(wander.x[j], wander.y[j]);
+        }
+    }
+
+    for (size_t count = 1; count < edges.size(); ++count) {
+        std::vector<intersect::EdgeIntersection> range(count);
+        intersect::edge_intersect_range(a1, a2, edges, 0, count, range.data());
+
+        for (size_t j = 0; j < count; ++j) {
+            intersect::EdgeIntersection expected = intersect::edge_intersect_scalar(
+                a1, a2, Point(edges.x[j], edges.y[j]), Point(edges.x[j + 1], edges.y[j + 1]));
+            EXPECT_EQ(range[j].intersects, expected.intersects) << count << " " << j;
+            EXPECT_EQ(range[j].t, expected.t) << count << " " << j;
+            EXPECT_EQ(range[j].u, expected.u) << count << " " << j;
+        }
+    }
+}
+
+TEST_F(DispatchTest, CalibratedProfileGivesSameResults) {
+    DispatchProfile profile = calibrate_dispatch();
+
+    // ISAs the CPU lacks aren't measured
+    auto caps = get_simd_capabilities();
+    if (!caps.avx512_available) {
+        EXPECT_EQ(profile.avx512_min_points, 0u);
+    }
+    if (!caps.avx2_available) {
+        EXPECT_EQ(profile.avx2_min_points, 0u);
+    }
+
+    set_dispatch_profile(profile);
+    for (size_t n : {4u, 40u, 400u, 4000u}) {
+        PolylineSoA line = create_wander(n, 11);
+        expect_same_line(simplify(line, 0.3), simplify(line, 0.3, SimplifyAlgorithm::SCALAR));
+    }
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "geom_simd/geom_simd.h"
+#include <cstdint>
+#include <new>
 
 using namespace geom;
 
@@ -13,6 +15,42 @@ TEST(GeometryTest, PointConstruction) {
     EXPECT_DOUBLE_EQ(p2.y, 7.2);
 }
 
+template <typename Line>
+void expect_aligned(const Line& line) {
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(line.x.data()) % kSimdAlignment, 0u) << "size " << line.size();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(line.y.data()) % kSimdAlignment, 0u) << "size " << line.size();
+}
+
+TEST(AlignedStorageTest, DataIsCacheLineAligned) {
+    PolylineSoA line;
+    PolylineSoAf line_f;
+    PolylineSoAi line_i;
+    // Every reallocation on the way up, including sizes at block boundaries
+    for (int i = 0; i < 1000; ++i) {
+        line.push_back(i, -i);
+        line_f.push_back(static_cast<float>(i), static_cast<float>(-i));
+        line_i.push_back(i, -i);
+        expect_aligned(line);
+        expect_aligned(line_f);
+        expect_aligned(line_i);
+    }
+    
+    for (size_t n : {1, 7, 8, 9, 15, 16, 17, 63, 64, 65}) {
+        PolylineSoA sized;
+        sized.reserve(n);
+        expect_aligned(sized);
+    }
+}
+
+TEST(AlignedStorageTest, OversizedAllocationThrows) {
+    // Sizes whose padded byte count would wrap around must not allocate
+    AlignedAllocator<double> allocator;
+    EXPECT_THROW(allocator.allocate(SIZE_MAX / sizeof(double)), std::bad_array_new_length);
+    EXPECT_THROW(allocator.allocate((SIZE_MAX - kSimdAlignment) / sizeof(double)),
+                 std::bad_array_new_length);
+    EXPECT_THROW(AlignedAllocator<float>().allocate(SIZE_MAX / 2), std::bad_array_new_length);
+}
+
 TEST(SIMDCapabilitiesTest, CanDetect) {
     auto caps = get_simd_capabilities();
     
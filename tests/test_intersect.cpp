@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "geom_simd/clip.h"
 #include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
 
 using namespace geom;
 using namespace geom::intersect;
@@ -91,9 +94,768 @@ TEST(EdgeIntersectTest, TIntersection) {
     EXPECT_NEAR(result.y, 0.0, 1e-6);
 }
 
-#ifdef HAVE_AVX512
+// Random vertices on a 4096 x 4096 tile grid
+PolylineSoAi random_grid_polyline(size_t n, unsigned seed) {
+    unsigned state = seed;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<int32_t>((state >> 8) % 4096);
+    };
+    
+    PolylineSoAi line;
+    for (size_t i = 0; i < n; ++i) {
+        int32_t x = next();
+        line.push_back(x, next());
+    }
+    return line;
+}
+
+// Every integer kernel finishes its hits with the same code
+void expect_same_intersection(const EdgeIntersection& a, const EdgeIntersection& b, int edge) {
+    EXPECT_EQ(a.intersects, b.intersects) << "edge " << edge;
+    EXPECT_EQ(a.t, b.t) << "edge " << edge;
+    EXPECT_EQ(a.u, b.u) << "edge " << edge;
+    EXPECT_EQ(a.x, b.x) << "edge " << edge;
+    EXPECT_EQ(a.y, b.y) << "edge " << edge;
+}
+
+// Every other vertex is put on edge A at a random parameter, some past its
+// ends, so B's edges start or end on A up to rounding: the pairs where a
+// fused cross product would decide differently from an unfused one
+PolylineSoA touching_polyline(const Point& a1, const Point& a2, size_t n, unsigned seed) {
+    unsigned state = seed;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<double>(state >> 8) / 16777216.0;  // [0, 1)
+    };
+    
+    PolylineSoA line;
+    for (size_t i = 0; i < n; ++i) {
+        if (i % 2 == 0) {
+            double s = 1.5 * next() - 0.25;
+            line.push_back(a1.x + s * (a2.x - a1.x), a1.y + s * (a2.y - a1.y));
+        } else {
+            double x = a1.x + 20.0 * next() - 10.0;
+            line.push_back(x, a1.y + 20.0 * next() - 10.0);
+        }
+    }
+    return line;
+}
+
+// A fixed-width kernel over touching_polyline() edges, bit for bit against
+// the scalar kernel. kernel(a1, a2, b, start, results) fills width results.
+template <typename Kernel>
+void expect_touching_matches_scalar(size_t width, Kernel kernel) {
+    int hits = 0, misses = 0;
+    for (unsigned trial = 0; trial < 200; ++trial) {
+        Point a1{0.1 * trial, 0.7}, a2{9.3, 4.1 + 0.013 * trial};
+        auto b = touching_polyline(a1, a2, 65, trial + 1);
+        for (size_t start = 0; start + width < b.size(); start += width) {
+            EdgeIntersection results[16];
+            kernel(a1, a2, b, start, results);
+            for (size_t i = 0; i < width; ++i) {
+                size_t j = start + i;
+                auto expected = edge_intersect_scalar(a1, a2, {b.x[j], b.y[j]}, {b.x[j + 1], b.y[j + 1]});
+                expect_same_intersection(expected, results[i], static_cast<int>(j));
+                (expected.intersects ? hits : misses) += 1;
+            }
+        }
+    }
+    EXPECT_GT(hits, 0);
+    EXPECT_GT(misses, 0);
+}
+
+TEST(EdgeIntersectTest, TouchingEndpointsRangeMatchesScalar) {
+    // Whatever kernel this CPU runs
+    expect_touching_matches_scalar(8, [](const Point& a1, const Point& a2, const PolylineSoA& b,
+                                         size_t start, EdgeIntersection* results) {
+        edge_intersect_range(a1, a2, b, start, 8, results);
+    });
+}
 
-TEST(EdgeIntersectAVX512Test, ConsistencyWithScalar) {
+TEST(EdgeIntersectTest, TouchingEndpointsBatchMatchesScalar) {
+    // Scatter the packed hits back to per-edge results
+    expect_touching_matches_scalar(8, [](const Point& a1, const Point& a2, const PolylineSoA& b,
+                                         size_t start, EdgeIntersection* results) {
+        EdgeHitsSoA hits;
+        edge_intersect_batch(a1, a2, b, start, 8, hits);
+        std::fill(results, results + 8, EdgeIntersection());
+        for (size_t h = 0; h < hits.size(); ++h) {
+            results[hits.edge[h] - start] = EdgeIntersection(true, hits.t[h], hits.u[h], hits.x[h], hits.y[h]);
+        }
+    });
+}
+
+// Edge A (0,0)-(2,0) against vertical edges: the denominator is
+// 2 * (B2.y - B1.y), and t = x/2 is decided on the exact numerators
+TEST(EdgeIntersectTest, RangeEndsAreDecidedOnNumerators) {
+    const double tiny = std::numeric_limits<double>::denorm_min();
+    auto crossing = [](double x, double y1) {
+        return edge_intersect_scalar({0, 0}, {2, 0}, {x, y1}, {x, 1});
+    };
+    
+    EXPECT_TRUE(crossing(0.0, -1.0).intersects);
+    EXPECT_EQ(crossing(0.0, -1.0).t, 0.0);
+    EXPECT_TRUE(crossing(2.0, -1.0).intersects);
+    EXPECT_EQ(crossing(2.0, -1.0).t, 1.0);
+    EXPECT_TRUE(crossing(1.0, 0.0).intersects);
+    EXPECT_EQ(crossing(1.0, 0.0).u, 0.0);
+    
+    // One ulp past A's end: the numerator is one ulp past the denominator
+    EXPECT_FALSE(crossing(std::nextafter(2.0, 3.0), -1.0).intersects);
+    
+    // t and u would divide to -0 and pass a t >= 0 test after dividing
+    EXPECT_FALSE(crossing(-tiny, -1.0).intersects);
+    EXPECT_FALSE(crossing(1.0, tiny).intersects);
+}
+
+TEST(EdgeIntersectTest, FixedPointMatchesDoubleOnGrid) {
+    auto a = random_grid_polyline(200, 3);
+    auto b = random_grid_polyline(200, 4);
+    int hits = 0;
+    for (size_t i = 0; i + 1 < a.size(); ++i) {
+        for (size_t j = 0; j + 1 < b.size(); j += 7) {
+            auto exact = edge_intersect_scalar_i32({a.x[i], a.y[i]}, {a.x[i + 1], a.y[i + 1]},
+                                                   {b.x[j], b.y[j]}, {b.x[j + 1], b.y[j + 1]});
+            auto reference = edge_intersect_scalar({double(a.x[i]), double(a.y[i])},
+                                                   {double(a.x[i + 1]), double(a.y[i + 1])},
+                                                   {double(b.x[j]), double(b.y[j])},
+                                                   {double(b.x[j + 1]), double(b.y[j + 1])});
+            EXPECT_TRUE(edge_intersections_equal(reference, exact)) << i << " x " << j;
+            hits += exact.intersects ? 1 : 0;
+        }
+    }
+    EXPECT_GT(hits, 0);
+}
+
+TEST(EdgeIntersectTest, FixedPointIsExactAtLargeCoordinates) {
+    // (p, q) lies exactly on A at t = 1/3, far beyond where double products are exact
+    const int32_t p = 300000007, q = 299999989;
+    PointI a1{0, 0}, a2{3 * p, 3 * q};
+    
+    auto starts_on_a = edge_intersect_scalar_i32(a1, a2, {p, q}, {p + 1, q - 7});
+    EXPECT_TRUE(starts_on_a.intersects);
+    EXPECT_EQ(starts_on_a.u, 0.0);
+    EXPECT_NEAR(starts_on_a.t, 1.0 / 3.0, 1e-15);
+    
+    auto ends_on_a = edge_intersect_scalar_i32(a1, a2, {p - 1, q + 7}, {p, q});
+    EXPECT_TRUE(ends_on_a.intersects);
+    EXPECT_EQ(ends_on_a.u, 1.0);
+    
+    // One grid step above A along its whole length: a near miss
+    auto above = edge_intersect_scalar_i32(a1, a2, {p + 1, q + 1}, {p - 1, q + 1});
+    EXPECT_FALSE(above.intersects);
+    
+    // Collinear overlap is rejected like the double kernel does
+    EXPECT_FALSE(edge_intersect_scalar_i32(a1, a2, {p, q}, {2 * p, 2 * q}).intersects);
+}
+
+// edge_intersect_range() runs whatever this CPU has; every count exercises
+// a different mix of full blocks and tail
+TEST(EdgeIntersectTest, RangeMatchesScalar) {
+    auto grid = random_grid_polyline(64, 7);
+    auto a = random_grid_polyline(6, 8);
+    
+    for (size_t start : {0, 1, 5}) {
+        for (size_t count = 0; start + count + 1 <= grid.size(); ++count) {
+            // Exactly the vertices the range needs
+            PolylineSoAi bi;
+            PolylineSoA bd;
+            PolylineSoAf bf;
+            for (size_t j = 0; j < start + count + 1; ++j) {
+                bi.push_back(grid.x[j], grid.y[j]);
+                bd.push_back(grid.x[j], grid.y[j]);
+                // Small enough that float products are exact
+                bf.push_back(static_cast<float>(grid.x[j] % 256), static_cast<float>(grid.y[j] % 256));
+            }
+            
+            for (size_t k = 0; k + 1 < a.size(); ++k) {
+                PointI a1{a.x[k], a.y[k]}, a2{a.x[k + 1], a.y[k + 1]};
+                Point d1{double(a1.x), double(a1.y)}, d2{double(a2.x), double(a2.y)};
+                Point f1{double(a1.x % 256), double(a1.y % 256)}, f2{double(a2.x % 256), double(a2.y % 256)};
+                
+                std::vector<EdgeIntersection> ri(count), rd(count), rf(count);
+                edge_intersect_range(a1, a2, bi, start, count, ri.data());
+                edge_intersect_range(d1, d2, bd, start, count, rd.data());
+                edge_intersect_range(f1, f2, bf, start, count, rf.data());
+                
+                for (size_t i = 0; i < count; ++i) {
+                    size_t j = start + i;
+                    expect_same_intersection(
+                        edge_intersect_scalar_i32(a1, a2, {bi.x[j], bi.y[j]}, {bi.x[j + 1], bi.y[j + 1]}),
+                        ri[i], static_cast<int>(j));
+                    EXPECT_TRUE(edge_intersections_equal(
+                        edge_intersect_scalar(d1, d2, {bd.x[j], bd.y[j]}, {bd.x[j + 1], bd.y[j + 1]}),
+                        rd[i])) << "count " << count << ", edge " << j;
+                    EXPECT_TRUE(edge_intersections_equal(
+                        edge_intersect_scalar(f1, f2, {bf.x[j], bf.y[j]}, {bf.x[j + 1], bf.y[j + 1]}),
+                        rf[i], 1e-4)) << "count " << count << ", edge " << j;
+                }
+            }
+        }
+    }
+}
+
+// Only hits come back, with their edge index, appended across calls
+TEST(EdgeIntersectTest, BatchMatchesRange) {
+    auto grid = random_grid_polyline(80, 13);
+    auto a = random_grid_polyline(6, 14);
+    
+    for (size_t start : {0, 1, 5}) {
+        for (size_t count = 0; start + count + 1 <= grid.size(); ++count) {
+            // Exactly the vertices the batch needs
+            PolylineSoA b;
+            for (size_t j = 0; j < start + count + 1; ++j) {
+                b.push_back(grid.x[j], grid.y[j]);
+            }
+            
+            EdgeHitsSoA hits;
+            std::vector<EdgeIntersection> expected;
+            std::vector<size_t> expected_edges;
+            for (size_t k = 0; k + 1 < a.size(); ++k) {
+                Point a1{double(a.x[k]), double(a.y[k])}, a2{double(a.x[k + 1]), double(a.y[k + 1])};
+                size_t before = hits.size();
+                size_t appended = edge_intersect_batch(a1, a2, b, start, count, hits);
+                EXPECT_EQ(hits.size(), before + appended);
+                for (size_t j = start; j < start + count; ++j) {
+                    auto r = edge_intersect_scalar(a1, a2, {b.x[j], b.y[j]}, {b.x[j + 1], b.y[j + 1]});
+                    if (r.intersects) {
+                        expected.push_back(r);
+                        expected_edges.push_back(j);
+                    }
+                }
+            }
+            
+            ASSERT_EQ(hits.size(), expected.size()) << "start " << start << ", count " << count;
+            for (size_t h = 0; h < hits.size(); ++h) {
+                EXPECT_EQ(hits.edge[h], expected_edges[h]) << "hit " << h;
+                EXPECT_TRUE(edge_intersections_equal(
+                    expected[h], EdgeIntersection(true, hits.t[h], hits.u[h], hits.x[h], hits.y[h])))
+                    << "hit " << h;
+            }
+        }
+    }
+}
+
+Polygon grid_polygon(size_t n, unsigned seed, bool closed) {
+    auto grid = random_grid_polyline(n, seed);
+    Polygon polygon;
+    for (size_t i = 0; i < grid.size(); ++i) {
+        polygon.vertices.push_back(grid.x[i], grid.y[i]);
+    }
+    if (closed) {
+        polygon.close();
+    }
+    return polygon;
+}
+
+// Every edge pair, closing edges included, through the scalar kernel
+std::vector<EdgeHit> all_pairs_reference(const Polygon& a, const Polygon& b) {
+    auto edges = [](const Polygon& p) {
+        size_t stored = p.size() < 2 ? 0 : p.size() - 1;
+        return stored + ((p.size() >= 3 && !p.is_closed()) ? 1 : 0);
+    };
+    std::vector<EdgeHit> hits;
+    for (size_t i = 0; i < edges(a); ++i) {
+        size_t i2 = (i + 1) % a.size();
+        for (size_t j = 0; j < edges(b); ++j) {
+            size_t j2 = (j + 1) % b.size();
+            auto r = edge_intersect_scalar({a.vertices.x[i], a.vertices.y[i]},
+                                           {a.vertices.x[i2], a.vertices.y[i2]},
+                                           {b.vertices.x[j], b.vertices.y[j]},
+                                           {b.vertices.x[j2], b.vertices.y[j2]});
+            if (r.intersects) {
+                hits.push_back({i, j, r.t, r.u, r.x, r.y});
+            }
+        }
+    }
+    return hits;
+}
+
+TEST(FindAllIntersectionsTest, OverlappingSquares) {
+    Polygon a, b;
+    a.vertices = PolylineSoA({{0, 0}, {10, 0}, {10, 10}, {0, 10}, {0, 0}});
+    // Open ring: its closing edge (3) runs from (5, 15) back to (5, 5)
+    b.vertices = PolylineSoA({{5, 5}, {15, 5}, {15, 15}, {5, 15}});
+    
+    auto hits = find_all_intersections(a, b, SimplifyAlgorithm::SCALAR);
+    ASSERT_EQ(hits.size(), 2u);
+    EXPECT_EQ(hits[0].a_edge, 1u);
+    EXPECT_EQ(hits[0].b_edge, 0u);
+    EXPECT_NEAR(hits[0].x, 10.0, 1e-12);
+    EXPECT_NEAR(hits[0].y, 5.0, 1e-12);
+    EXPECT_EQ(hits[1].a_edge, 2u);
+    EXPECT_EQ(hits[1].b_edge, 3u);
+    EXPECT_NEAR(hits[1].x, 5.0, 1e-12);
+    EXPECT_NEAR(hits[1].y, 10.0, 1e-12);
+    EXPECT_NEAR(hits[1].t, 0.5, 1e-12);
+    EXPECT_NEAR(hits[1].u, 0.5, 1e-12);
+}
+
+TEST(FindAllIntersectionsTest, DegeneratePolygonsHaveNoHits) {
+    Polygon empty, point, square;
+    point.vertices.push_back(1, 1);
+    square.vertices = PolylineSoA({{0, 0}, {10, 0}, {10, 10}, {0, 10}, {0, 0}});
+    EXPECT_TRUE(find_all_intersections(empty, square).empty());
+    EXPECT_TRUE(find_all_intersections(square, point).empty());
+}
+
+TEST(FindAllIntersectionsTest, NoNeonIntersectionKernels) {
+    auto square = grid_polygon(8, 1, true);
+    EXPECT_THROW(find_all_intersections(square, square, SimplifyAlgorithm::NEON), std::runtime_error);
+}
+
+// Each back end against every pair through the scalar kernel. Grid
+// coordinates keep the cross products exact, so fused kernels agree too.
+class FindAllIntersectionsBackendTest : public ::testing::TestWithParam<SimplifyAlgorithm> {
+protected:
+    void SetUp() override {
+        auto caps = get_simd_capabilities();
+        if ((GetParam() == SimplifyAlgorithm::SSE2 && !caps.sse2_available) ||
+            (GetParam() == SimplifyAlgorithm::AVX2 && !caps.avx2_available) ||
+            (GetParam() == SimplifyAlgorithm::AVX512 && !caps.avx512_available)) {
+            GTEST_SKIP() << "ISA not available on this CPU";
+        }
+    }
+};
+
+TEST_P(FindAllIntersectionsBackendTest, MatchesAllPairs) {
+    // B sizes straddle the 64-edge blocks
+    for (size_t nb : {3, 9, 64, 65, 66, 200}) {
+        for (int closed = 0; closed < 2; ++closed) {
+            auto a = grid_polygon(37, static_cast<unsigned>(nb), closed != 0);
+            auto b = grid_polygon(nb, static_cast<unsigned>(nb) + 100, closed == 0);
+            
+            auto expected = all_pairs_reference(a, b);
+            auto actual = find_all_intersections(a, b, GetParam());
+            ASSERT_EQ(actual.size(), expected.size()) << "nb=" << nb << " closed=" << closed;
+            for (size_t k = 0; k < expected.size(); ++k) {
+                EXPECT_EQ(actual[k].a_edge, expected[k].a_edge) << "hit " << k;
+                EXPECT_EQ(actual[k].b_edge, expected[k].b_edge) << "hit " << k;
+                EXPECT_NEAR(actual[k].t, expected[k].t, 1e-9) << "hit " << k;
+                EXPECT_NEAR(actual[k].u, expected[k].u, 1e-9) << "hit " << k;
+                EXPECT_NEAR(actual[k].x, expected[k].x, 1e-6) << "hit " << k;
+                EXPECT_NEAR(actual[k].y, expected[k].y, 1e-6) << "hit " << k;
+            }
+        }
+    }
+}
+
+TEST_P(FindAllIntersectionsBackendTest, RingsSkipDistantBlocks) {
+    // Long rings, where most blocks of B lie far from any given edge of A
+    auto ring = [](double cx, double cy, size_t n) {
+        Polygon polygon;
+        for (size_t i = 0; i < n; ++i) {
+            double angle = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(n);
+            double radius = 1000.0 + 40.0 * ((i * 7) % 5);
+            polygon.vertices.push_back(std::round(cx + radius * std::cos(angle)),
+                                       std::round(cy + radius * std::sin(angle)));
+        }
+        polygon.close();
+        return polygon;
+    };
+    auto a = ring(0, 0, 500);
+    auto b = ring(700, 300, 700);
+    
+    auto expected = all_pairs_reference(a, b);
+    auto actual = find_all_intersections(a, b, GetParam());
+    EXPECT_GT(expected.size(), 2u);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t k = 0; k < expected.size(); ++k) {
+        EXPECT_EQ(actual[k].a_edge, expected[k].a_edge) << "hit " << k;
+        EXPECT_EQ(actual[k].b_edge, expected[k].b_edge) << "hit " << k;
+        EXPECT_NEAR(actual[k].x, expected[k].x, 1e-6) << "hit " << k;
+        EXPECT_NEAR(actual[k].y, expected[k].y, 1e-6) << "hit " << k;
+    }
+}
+
+TEST_P(FindAllIntersectionsBackendTest, PolylinesMatchAllPairs) {
+    auto to_double = [](const PolylineSoAi& line) {
+        PolylineSoA out;
+        for (size_t i = 0; i < line.size(); ++i) {
+            out.push_back(line.x[i], line.y[i]);
+        }
+        return out;
+    };
+
+    // Edge counts straddle the register tiles and both cache blocks
+    const std::pair<size_t, size_t> sizes[] = {{0, 5}, {1, 2}, {40, 33}, {40, 70}, {600, 70}, {40, 8200}};
+    for (auto [na, nb] : sizes) {
+        auto a = to_double(random_grid_polyline(na + 1, static_cast<unsigned>(na) + 20));
+        auto b = to_double(random_grid_polyline(nb + 1, static_cast<unsigned>(nb) + 30));
+
+        std::vector<EdgeHit> expected;
+        for (size_t i = 0; i + 1 < a.size(); ++i) {
+            for (size_t j = 0; j + 1 < b.size(); ++j) {
+                auto r = edge_intersect_scalar({a.x[i], a.y[i]}, {a.x[i + 1], a.y[i + 1]},
+                                               {b.x[j], b.y[j]}, {b.x[j + 1], b.y[j + 1]});
+                if (r.intersects) {
+                    expected.push_back({i, j, r.t, r.u, r.x, r.y});
+                }
+            }
+        }
+
+        auto actual = find_all_intersections(a, b, GetParam());
+        ASSERT_EQ(actual.size(), expected.size()) << na << " x " << nb;
+        for (size_t k = 0; k < expected.size(); ++k) {
+            ASSERT_EQ(actual[k].a_edge, expected[k].a_edge) << na << " x " << nb << " hit " << k;
+            ASSERT_EQ(actual[k].b_edge, expected[k].b_edge) << na << " x " << nb << " hit " << k;
+            EXPECT_NEAR(actual[k].t, expected[k].t, 1e-9) << "hit " << k;
+            EXPECT_NEAR(actual[k].u, expected[k].u, 1e-9) << "hit " << k;
+            EXPECT_NEAR(actual[k].x, expected[k].x, 1e-6) << "hit " << k;
+            EXPECT_NEAR(actual[k].y, expected[k].y, 1e-6) << "hit " << k;
+        }
+    }
+}
+
+// Two combs crossing each other: every A edge hits most B edges, far more
+// hits per tile than the spare room find_all_intersections() starts with
+TEST_P(FindAllIntersectionsBackendTest, DenseTilesMatchAllPairs) {
+    PolylineSoA a;
+    PolylineSoA b;
+    for (int i = 0; i < 120; ++i) {
+        a.push_back(2.0 * i + 0.5, i % 2 ? 300.0 : -1.0);
+        b.push_back(i % 2 ? 300.0 : -1.0, 2.0 * i + 0.25);
+    }
+
+    std::vector<EdgeHit> expected;
+    for (size_t i = 0; i + 1 < a.size(); ++i) {
+        for (size_t j = 0; j + 1 < b.size(); ++j) {
+            auto r = edge_intersect_scalar({a.x[i], a.y[i]}, {a.x[i + 1], a.y[i + 1]},
+                                           {b.x[j], b.y[j]}, {b.x[j + 1], b.y[j + 1]});
+            if (r.intersects) {
+                expected.push_back({i, j, r.t, r.u, r.x, r.y});
+            }
+        }
+    }
+    ASSERT_GT(expected.size(), 4096u);
+
+    auto actual = find_all_intersections(a, b, GetParam());
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t k = 0; k < expected.size(); ++k) {
+        ASSERT_EQ(actual[k].a_edge, expected[k].a_edge) << "hit " << k;
+        ASSERT_EQ(actual[k].b_edge, expected[k].b_edge) << "hit " << k;
+        EXPECT_EQ(actual[k].t, expected[k].t) << "hit " << k;
+        EXPECT_EQ(actual[k].u, expected[k].u) << "hit " << k;
+        EXPECT_EQ(actual[k].x, expected[k].x) << "hit " << k;
+        EXPECT_EQ(actual[k].y, expected[k].y) << "hit " << k;
+    }
+}
+
+TEST_P(FindAllIntersectionsBackendTest, TouchingEdgesMatchScalar) {
+    // Every other vertex of B lies on an edge of A up to rounding, over
+    // more than one block and register tile of B
+    Polygon a, b;
+    a.vertices = touching_polyline({0.3, 0.1}, {9.7, 5.3}, 40, 5);
+    unsigned state = 17;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<double>(state >> 8) / 16777216.0;
+    };
+    for (size_t j = 0; j < 150; ++j) {
+        if (j % 2 == 0) {
+            size_t i = static_cast<size_t>(next() * 39.0);
+            double s = 1.2 * next() - 0.1;
+            b.vertices.push_back(a.vertices.x[i] + s * (a.vertices.x[i + 1] - a.vertices.x[i]),
+                                 a.vertices.y[i] + s * (a.vertices.y[i + 1] - a.vertices.y[i]));
+        } else {
+            b.vertices.push_back(12.0 * next() - 1.0, 12.0 * next() - 4.0);
+        }
+    }
+    
+    auto expect_same_hits = [](const std::vector<EdgeHit>& actual, const std::vector<EdgeHit>& expected) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t k = 0; k < expected.size(); ++k) {
+            EXPECT_EQ(actual[k].a_edge, expected[k].a_edge) << "hit " << k;
+            EXPECT_EQ(actual[k].b_edge, expected[k].b_edge) << "hit " << k;
+            EXPECT_EQ(actual[k].t, expected[k].t) << "hit " << k;
+            EXPECT_EQ(actual[k].u, expected[k].u) << "hit " << k;
+            EXPECT_EQ(actual[k].x, expected[k].x) << "hit " << k;
+            EXPECT_EQ(actual[k].y, expected[k].y) << "hit " << k;
+        }
+    };
+    
+    // Open rings, so both closing edges are tested too
+    auto expected = all_pairs_reference(a, b);
+    EXPECT_GT(expected.size(), 10u);
+    expect_same_hits(find_all_intersections(a, b, GetParam()), expected);
+    
+    // The polyline version has no closing edges
+    std::vector<EdgeHit> expected_open;
+    for (const EdgeHit& hit : expected) {
+        if (hit.a_edge + 1 < a.size() && hit.b_edge + 1 < b.size()) {
+            expected_open.push_back(hit);
+        }
+    }
+    expect_same_hits(find_all_intersections(a.vertices, b.vertices, GetParam()), expected_open);
+}
+
+TEST_P(FindAllIntersectionsBackendTest, RangeEndsMatchScalar) {
+    // The edges of RangeEndsAreDecidedOnNumerators as every other edge of
+    // B, joined by diagonals, for each kernel
+    const double tiny = std::numeric_limits<double>::denorm_min();
+    const std::pair<double, double> ends[] = {
+        {0.0, -1.0}, {-tiny, -1.0}, {2.0, -1.0}, {std::nextafter(2.0, 3.0), -1.0},
+        {1.0, 0.0}, {1.0, tiny}, {1.0, -tiny}, {std::nextafter(0.0, 1.0) * 4, -1.0}};
+    PolylineSoA a, b;
+    a.push_back(0.0, 0.0);
+    a.push_back(2.0, 0.0);
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        for (auto [x, y1] : ends) {
+            b.push_back(x, y1);
+            b.push_back(x, 1.0);
+        }
+    }
+    
+    std::vector<EdgeHit> expected;
+    for (size_t j = 0; j + 1 < b.size(); ++j) {
+        auto r = edge_intersect_scalar({0, 0}, {2, 0}, {b.x[j], b.y[j]}, {b.x[j + 1], b.y[j + 1]});
+        if (r.intersects) {
+            expected.push_back({0, j, r.t, r.u, r.x, r.y});
+        }
+    }
+    EXPECT_GT(expected.size(), 3u);
+    
+    auto actual = find_all_intersections(a, b, GetParam());
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t k = 0; k < expected.size(); ++k) {
+        EXPECT_EQ(actual[k].b_edge, expected[k].b_edge) << "hit " << k;
+        EXPECT_EQ(actual[k].t, expected[k].t) << "hit " << k;
+        EXPECT_EQ(actual[k].u, expected[k].u) << "hit " << k;
+    }
+    
+    // And the one-edge-at-a-time kernels behind the polygon version
+    Polygon pa, pb;
+    pa.vertices = a;
+    pb.vertices = b;
+    auto polygon_hits = find_all_intersections(pa, pb, GetParam());
+    std::vector<EdgeHit> stored;
+    for (const EdgeHit& hit : polygon_hits) {
+        if (hit.b_edge + 1 < b.size()) {
+            stored.push_back(hit);
+        }
+    }
+    ASSERT_EQ(stored.size(), expected.size());
+    for (size_t k = 0; k < expected.size(); ++k) {
+        EXPECT_EQ(stored[k].b_edge, expected[k].b_edge) << "hit " << k;
+        EXPECT_EQ(stored[k].t, expected[k].t) << "hit " << k;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Portable, FindAllIntersectionsBackendTest,
+                         ::testing::Values(SimplifyAlgorithm::SCALAR, SimplifyAlgorithm::AUTO));
+
+INSTANTIATE_TEST_SUITE_P(Sse2, FindAllIntersectionsBackendTest,
+                         ::testing::Values(SimplifyAlgorithm::SSE2));
+
+INSTANTIATE_TEST_SUITE_P(Avx2, FindAllIntersectionsBackendTest,
+                         ::testing::Values(SimplifyAlgorithm::AVX2));
+
+INSTANTIATE_TEST_SUITE_P(Avx512, FindAllIntersectionsBackendTest,
+                         ::testing::Values(SimplifyAlgorithm::AVX512));
+
+// ISA kernels are only called where the CPU has them
+class EdgeIntersectSSE2Test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!get_simd_capabilities().sse2_available) {
+            GTEST_SKIP() << "SSE2 not available";
+        }
+    }
+};
+
+TEST_F(EdgeIntersectSSE2Test, ConsistencyWithScalar) {
+    auto grid = random_grid_polyline(65, 9);
+    auto a = random_grid_polyline(12, 10);
+    PolylineSoA b;
+    for (size_t j = 0; j < grid.size(); ++j) {
+        b.push_back(grid.x[j], grid.y[j]);
+    }
+    
+    int hits = 0;
+    for (size_t k = 0; k + 1 < a.size(); ++k) {
+        Point a1{double(a.x[k]), double(a.y[k])}, a2{double(a.x[k + 1]), double(a.y[k + 1])};
+        for (size_t start = 0; start + 2 < b.size(); ++start) {
+            EdgeIntersection results[2];
+            edge_intersect_sse2(a1, a2, b, start, results);
+            for (size_t i = 0; i < 2; ++i) {
+                size_t j = start + i;
+                auto expected = edge_intersect_scalar(a1, a2, {b.x[j], b.y[j]}, {b.x[j + 1], b.y[j + 1]});
+                EXPECT_TRUE(edge_intersections_equal(expected, results[i])) << "edge " << j;
+                hits += results[i].intersects ? 1 : 0;
+            }
+        }
+    }
+    EXPECT_GT(hits, 0);
+}
+
+TEST_F(EdgeIntersectSSE2Test, TouchingEndpointsMatchScalar) {
+    expect_touching_matches_scalar(2, [](const Point& a1, const Point& a2, const PolylineSoA& b,
+                                         size_t start, EdgeIntersection* results) {
+        edge_intersect_sse2(a1, a2, b, start, results);
+    });
+}
+
+class EdgeIntersectNEONTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!get_simd_capabilities().neon_available) {
+            GTEST_SKIP() << "NEON not available";
+        }
+    }
+};
+
+TEST_F(EdgeIntersectNEONTest, TouchingEndpointsMatchScalar) {
+    expect_touching_matches_scalar(2, [](const Point& a1, const Point& a2, const PolylineSoA& b,
+                                         size_t start, EdgeIntersection* results) {
+        edge_intersect_neon(a1.x, a1.y, a2.x, a2.y, b, start, results);
+    });
+}
+
+class EdgeIntersectAVX2Test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!get_simd_capabilities().avx2_available) {
+            GTEST_SKIP() << "AVX2 not available";
+        }
+    }
+};
+
+TEST_F(EdgeIntersectAVX2Test, ConsistencyWithScalar) {
+    auto grid = random_grid_polyline(65, 11);
+    auto a = random_grid_polyline(12, 12);
+    PolylineSoA b;
+    for (size_t j = 0; j < grid.size(); ++j) {
+        b.push_back(grid.x[j], grid.y[j]);
+    }
+    
+    int hits = 0;
+    for (size_t k = 0; k + 1 < a.size(); ++k) {
+        Point a1{double(a.x[k]), double(a.y[k])}, a2{double(a.x[k + 1]), double(a.y[k + 1])};
+        for (size_t start = 0; start + 4 < b.size(); ++start) {
+            EdgeIntersection results[4];
+            edge_intersect_avx2(a1.x, a1.y, a2.x, a2.y, b, start, results);
+            for (size_t i = 0; i < 4; ++i) {
+                size_t j = start + i;
+                auto expected = edge_intersect_scalar(a1, a2, {b.x[j], b.y[j]}, {b.x[j + 1], b.y[j + 1]});
+                EXPECT_TRUE(edge_intersections_equal(expected, results[i])) << "edge " << j;
+                hits += results[i].intersects ? 1 : 0;
+            }
+        }
+    }
+    EXPECT_GT(hits, 0);
+}
+
+TEST_F(EdgeIntersectAVX2Test, TouchingEndpointsMatchScalar) {
+    expect_touching_matches_scalar(4, [](const Point& a1, const Point& a2, const PolylineSoA& b,
+                                         size_t start, EdgeIntersection* results) {
+        edge_intersect_avx2(a1.x, a1.y, a2.x, a2.y, b, start, results);
+    });
+}
+
+TEST_F(EdgeIntersectAVX2Test, Float32ConsistencyWithScalar) {
+    // 8 edges fanning across the test edge, some missing it
+    PolylineSoAf b_vertices;
+    for (int i = 0; i < 9; ++i) {
+        b_vertices.push_back(static_cast<float>(i), i % 2 ? 12.0f : -3.0f + 0.5f * i);
+    }
+    
+    Point a1{0.0, 2.0}, a2{5.5, 6.0};  // Ends short of the last edges
+    EdgeIntersection simd_results[8];
+    edge_intersect_avx2(a1, a2, b_vertices, 0, simd_results);
+    
+    int hits = 0;
+    for (int i = 0; i < 8; ++i) {
+        auto scalar_result = edge_intersect_scalar(
+            a1, a2,
+            {b_vertices.x[i], b_vertices.y[i]},
+            {b_vertices.x[i + 1], b_vertices.y[i + 1]}
+        );
+        
+        EXPECT_TRUE(edge_intersections_equal(scalar_result, simd_results[i], 1e-4))
+            << "Mismatch at edge " << i;
+        hits += simd_results[i].intersects ? 1 : 0;
+    }
+    EXPECT_GT(hits, 0);
+    EXPECT_LT(hits, 8);
+}
+
+// Both float kernels do the same unfused float math, so on a CPU that has
+// both they must agree exactly, not just within float rounding
+TEST_F(EdgeIntersectAVX2Test, Float32MatchesAVX512) {
+    if (!get_simd_capabilities().avx512_available) {
+        GTEST_SKIP() << "AVX-512 not available";
+    }
+    
+    auto grid = random_grid_polyline(129, 13);
+    PolylineSoAf b;
+    for (size_t j = 0; j < grid.size(); ++j) {
+        b.push_back(static_cast<float>(grid.x[j]) * 0.37f, static_cast<float>(grid.y[j]) * 0.41f);
+    }
+    
+    int hits = 0;
+    for (size_t k = 0; k + 1 < b.size(); k += 7) {
+        Point a1{b.x[k] + 0.1, b.y[k] - 0.3}, a2{b.x[k + 1] * 1.5, b.y[k + 1] + 2.0};
+        for (size_t start = 0; start + 16 < b.size(); start += 16) {
+            EdgeIntersection narrow[16], wide[16];
+            edge_intersect_avx2(a1, a2, b, start, narrow);
+            edge_intersect_avx2(a1, a2, b, start + 8, narrow + 8);
+            edge_intersect_avx512(a1, a2, b, start, wide);
+            for (int i = 0; i < 16; ++i) {
+                expect_same_intersection(wide[i], narrow[i], static_cast<int>(start + i));
+                hits += wide[i].intersects ? 1 : 0;
+            }
+        }
+    }
+    EXPECT_GT(hits, 0);
+}
+
+TEST_F(EdgeIntersectAVX2Test, FixedPointMatchesScalar) {
+    auto b = random_grid_polyline(257, 5);
+    auto a = random_grid_polyline(20, 6);
+    for (size_t k = 0; k + 1 < a.size(); ++k) {
+        PointI a1{a.x[k], a.y[k]}, a2{a.x[k + 1], a.y[k + 1]};
+        for (size_t start = 0; start + 4 < b.size(); start += 4) {
+            EdgeIntersection results[4];
+            edge_intersect_avx2_i32(a1, a2, b, start, results);
+            for (int i = 0; i < 4; ++i) {
+                size_t j = start + i;
+                expect_same_intersection(
+                    edge_intersect_scalar_i32(a1, a2, {b.x[j], b.y[j]}, {b.x[j + 1], b.y[j + 1]}),
+                    results[i], static_cast<int>(j));
+            }
+        }
+    }
+}
+
+class EdgeIntersectAVX512Test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!get_simd_capabilities().avx512_available) {
+            GTEST_SKIP() << "AVX-512 not available";
+        }
+    }
+};
+
+TEST_F(EdgeIntersectAVX512Test, FixedPointMatchesScalar) {
+    auto b = random_grid_polyline(257, 5);
+    auto a = random_grid_polyline(20, 6);
+    for (size_t k = 0; k + 1 < a.size(); ++k) {
+        PointI a1{a.x[k], a.y[k]}, a2{a.x[k + 1], a.y[k + 1]};
+        for (size_t start = 0; start + 8 < b.size(); start += 8) {
+            EdgeIntersection results[8];
+            edge_intersect_avx512_i32(a1, a2, b, start, results);
+            for (int i = 0; i < 8; ++i) {
+                size_t j = start + i;
+                expect_same_intersection(
+                    edge_intersect_scalar_i32(a1, a2, {b.x[j], b.y[j]}, {b.x[j + 1], b.y[j + 1]}),
+                    results[i], static_cast<int>(j));
+            }
+        }
+    }
+}
+
+TEST_F(EdgeIntersectAVX512Test, ConsistencyWithScalar) {
     // Create 8 edges to test
     PolylineSoA b_vertices;
     b_vertices.x = {0, 0, 1, 2, 3, 4, 5, 6, 7};
@@ -119,7 +881,14 @@ TEST(EdgeIntersectAVX512Test, ConsistencyWithScalar) {
     }
 }
 
-TEST(EdgeIntersectAVX512Test, MultipleIntersections) {
+TEST_F(EdgeIntersectAVX512Test, TouchingEndpointsMatchScalar) {
+    expect_touching_matches_scalar(8, [](const Point& a1, const Point& a2, const PolylineSoA& b,
+                                         size_t start, EdgeIntersection* results) {
+        edge_intersect_avx512(a1, a2, b, start, results);
+    });
+}
+
+TEST_F(EdgeIntersectAVX512Test, MultipleIntersections) {
     // Create polygon edges that intersect with test edge
     PolylineSoA b_vertices;
     b_vertices.x = {0, 10, 0, 10, 15, 20, 25, 30, 35};
@@ -139,7 +908,7 @@ TEST(EdgeIntersectAVX512Test, MultipleIntersections) {
     EXPECT_TRUE(results[1].intersects);
 }
 
-TEST(EdgeIntersectAVX512Test, NoIntersections) {
+TEST_F(EdgeIntersectAVX512Test, NoIntersections) {
     // All edges far from test edge
     PolylineSoA b_vertices;
     b_vertices.x = {20, 21, 22, 23, 24, 25, 26, 27, 28};
@@ -157,7 +926,7 @@ TEST(EdgeIntersectAVX512Test, NoIntersections) {
     }
 }
 
-TEST(EdgeIntersectAVX512Test, MixedIntersections) {
+TEST_F(EdgeIntersectAVX512Test, MixedIntersections) {
     // Some edges intersect, some don't
     PolylineSoA b_vertices;
     b_vertices.x = {0, 10, 20, 30, 10, 0, 0, 10, 40};
@@ -179,4 +948,59 @@ TEST(EdgeIntersectAVX512Test, MixedIntersections) {
     EXPECT_FALSE(results[7].intersects);  // {(10,5)(40,0)} far away, doesn't cross
 }
 
-#endif // HAVE_AVX512
+TEST_F(EdgeIntersectAVX512Test, MaskedTailMatchesFullWidth) {
+    // Exact-size vectors: the masked kernel must not need any vertex past
+    // start_idx + count
+    PolylineSoA b_vertices;
+    b_vertices.x = {0, 10, 20, 30, 10, 0, 0, 10, 40};
+    b_vertices.y = {0, 10, 0, 10, 0, 10, 5, 5, 0};
+    
+    double ax1 = 5, ay1 = 0, ax2 = 5, ay2 = 10;
+    
+    EdgeIntersection full[8];
+    edge_intersect_avx512({ax1, ay1}, {ax2, ay2}, b_vertices, 0, full);
+    
+    for (size_t count = 0; count <= 8; ++count) {
+        EdgeIntersection masked[8];
+        edge_intersect_avx512_masked({ax1, ay1}, {ax2, ay2}, b_vertices, 0, count, masked);
+        for (size_t i = 0; i < 8; ++i) {
+            if (i < count) {
+                EXPECT_TRUE(edge_intersections_equal(full[i], masked[i]))
+                    << "count " << count << ", edge " << i;
+            } else {
+                EXPECT_FALSE(masked[i].intersects) << "count " << count << ", edge " << i;
+            }
+        }
+    }
+    
+    // Last three edges from an offset start
+    EdgeIntersection masked[8];
+    edge_intersect_avx512_masked({ax1, ay1}, {ax2, ay2}, b_vertices, 5, 3, masked);
+    EXPECT_FALSE(masked[0].intersects);
+    EXPECT_TRUE(masked[1].intersects);
+    EXPECT_FALSE(masked[2].intersects);
+}
+
+TEST_F(EdgeIntersectAVX512Test, Float32ConsistencyWithScalar) {
+    // 16 edges fanning across the test edge, some missing it
+    PolylineSoAf b_vertices;
+    for (int i = 0; i < 17; ++i) {
+        b_vertices.push_back(static_cast<float>(i), i % 2 ? 12.0f : -3.0f + 0.5f * i);
+    }
+    
+    Point a1{0.0, 2.0}, a2{16.0, 6.0};
+    EdgeIntersection simd_results[16];
+    edge_intersect_avx512(a1, a2, b_vertices, 0, simd_results);
+    
+    for (int i = 0; i < 16; ++i) {
+        auto scalar_result = edge_intersect_scalar(
+            a1, a2,
+            {b_vertices.x[i], b_vertices.y[i]},
+            {b_vertices.x[i + 1], b_vertices.y[i + 1]}
+        );
+        
+        EXPECT_TRUE(edge_intersections_equal(scalar_result, simd_results[i], 1e-4))
+            << "Mismatch at edge " << i;
+    }
+}
+
@@ -109,6 +109,53 @@ TEST_F(PolygonTest, ContainsPoint) {
     // Most implementations consider boundary as outside
 }
 
+TEST_F(PolygonTest, LargeRingMatchesScalarReference) {
+    // Enough vertices for the vector loops plus every tail length; checked
+    // both with and without the closing vertex
+    for (int n : {3, 4, 5, 6, 7, 50, 101}) {
+        Polygon poly;
+        for (int i = 0; i < n; ++i) {
+            double angle = 2.0 * M_PI * i / n;
+            double radius = 10.0 + 3.0 * ((i * 7) % 5);
+            poly.vertices.push_back(radius * std::cos(angle), radius * std::sin(angle));
+        }
+        
+        double expected = 0.0;
+        for (int i = 0; i < n; ++i) {
+            int j = (i + 1) % n;
+            expected += poly.vertices.x[i] * poly.vertices.y[j] -
+                        poly.vertices.x[j] * poly.vertices.y[i];
+        }
+        expected *= 0.5;
+        
+        auto inside = [&](double px, double py) {
+            bool odd = false;
+            for (int i = 0, j = n - 1; i < n; j = i++) {
+                double xi = poly.vertices.x[i], yi = poly.vertices.y[i];
+                double xj = poly.vertices.x[j], yj = poly.vertices.y[j];
+                if ((yi > py) != (yj > py) && px < (xj - xi) * (py - yi) / (yj - yi) + xi) {
+                    odd = !odd;
+                }
+            }
+            return odd;
+        };
+        
+        for (int closed = 0; closed < 2; ++closed) {
+            if (closed) {
+                poly.close();
+            }
+            EXPECT_NEAR(poly.signed_area(), expected, 1e-9 * std::abs(expected))
+                << "n=" << n << " closed=" << closed;
+            for (double px = -24.5; px < 25; px += 1.75) {
+                for (double py = -24.25; py < 25; py += 1.5) {
+                    EXPECT_EQ(poly.contains(px, py), inside(px, py))
+                        << "n=" << n << " closed=" << closed << " at " << px << "," << py;
+                }
+            }
+        }
+    }
+}
+
 TEST_F(PolygonTest, Close) {
     Polygon open_poly;
     open_poly.vertices = PolylineSoA({
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "geom_simd/geom_simd.h"
+#include <algorithm>
 #include <cmath>
+#include <set>
+#include <utility>
 
 using namespace geom;
 
@@ -149,6 +152,9 @@ TEST_P(SimplifyConsistencyTest, ConsistentResults) {
     if (algorithm == SimplifyAlgorithm::NEON && !caps.neon_available) {
         GTEST_SKIP();
     }
+    if (algorithm == SimplifyAlgorithm::SSE2 && !caps.sse2_available) {
+        GTEST_SKIP();
+    }
     
     auto line = create_test_line();
     double tolerance = 1.0;
@@ -166,10 +172,400 @@ INSTANTIATE_TEST_SUITE_P(
     ::testing::Values(
         SimplifyAlgorithm::SCALAR,
         SimplifyAlgorithm::AUTO
-        // AVX2, AVX512, NEON will be added when implemented
+        // NEON will be added when implemented
     )
 );
 
+INSTANTIATE_TEST_SUITE_P(
+    Sse2,
+    SimplifyConsistencyTest,
+    ::testing::Values(SimplifyAlgorithm::SSE2)
+);
+
+INSTANTIATE_TEST_SUITE_P(
+    Avx2,
+    SimplifyConsistencyTest,
+    ::testing::Values(SimplifyAlgorithm::AVX2)
+);
+
+INSTANTIATE_TEST_SUITE_P(
+    Avx512,
+    SimplifyConsistencyTest,
+    ::testing::Values(SimplifyAlgorithm::AVX512)
+);
+
+// Random walk long enough to exercise the vector loops and every tail length
+PolylineSoA create_random_walk(size_t n, unsigned seed) {
+    unsigned state = seed;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<double>(state >> 8) / static_cast<double>(1u << 24) - 0.5;
+    };
+
+    PolylineSoA line;
+    double x = 0.0, y = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        x += 1.0 + next();
+        y += 4.0 * next();
+        line.push_back(x, y);
+    }
+    return line;
+}
+
+// O(n^2) Visvalingam-Whyatt: rescan for the smallest effective area after
+// every removal. Same area expression, clamp and tie rule as simplify_vw().
+PolylineSoA reference_vw(const PolylineSoA& line, double area_tolerance) {
+    size_t n = line.size();
+    auto area = [&](size_t a, size_t b, size_t c) {
+        double cross = (line.x[b] - line.x[a]) * (line.y[c] - line.y[a]) -
+                       (line.y[b] - line.y[a]) * (line.x[c] - line.x[a]);
+        return 0.5 * std::fabs(cross);
+    };
+
+    std::vector<size_t> alive;
+    for (size_t i = 0; i < n; ++i) {
+        alive.push_back(i);
+    }
+    std::vector<double> effective(n, 0.0);
+    for (size_t k = 1; k + 1 < alive.size(); ++k) {
+        effective[alive[k]] = area(alive[k - 1], alive[k], alive[k + 1]);
+    }
+
+    while (alive.size() > 2) {
+        size_t best = 1;
+        for (size_t k = 2; k + 1 < alive.size(); ++k) {
+            if (effective[alive[k]] < effective[alive[best]]) {
+                best = k;
+            }
+        }
+        double removed = effective[alive[best]];
+        if (removed >= area_tolerance) {
+            break;
+        }
+        alive.erase(alive.begin() + static_cast<std::ptrdiff_t>(best));
+        if (best > 1) {
+            size_t k = best - 1;
+            effective[alive[k]] = std::max(area(alive[k - 1], alive[k], alive[k + 1]), removed);
+        }
+        if (best + 1 < alive.size()) {
+            size_t k = best;
+            effective[alive[k]] = std::max(area(alive[k - 1], alive[k], alive[k + 1]), removed);
+        }
+    }
+
+    PolylineSoA result;
+    for (size_t i : alive) {
+        result.push_back(line.x[i], line.y[i]);
+    }
+    return result;
+}
+
+// Each back end checked point-for-point against the scalar reference
+class SimplifyBackendTest : public ::testing::TestWithParam<SimplifyAlgorithm> {
+protected:
+    void SetUp() override {
+        auto caps = get_simd_capabilities();
+        if ((GetParam() == SimplifyAlgorithm::SSE2 && !caps.sse2_available) ||
+            (GetParam() == SimplifyAlgorithm::AVX2 && !caps.avx2_available) ||
+            (GetParam() == SimplifyAlgorithm::AVX512 && !caps.avx512_available)) {
+            GTEST_SKIP();
+        }
+    }
+};
+
+TEST_P(SimplifyBackendTest, MatchesScalarOnRandomWalks) {
+    for (size_t n : {3, 4, 5, 6, 7, 8, 9, 10, 17, 31, 100, 1000, 4099}) {
+        auto line = create_random_walk(n, static_cast<unsigned>(n));
+        for (double tolerance : {0.1, 0.5, 2.0}) {
+            auto expected = simplify(line, tolerance, SimplifyAlgorithm::SCALAR);
+            auto actual = simplify(line, tolerance, GetParam());
+            EXPECT_TRUE(polylines_equal(expected, actual))
+                << "n=" << n << " tolerance=" << tolerance;
+        }
+    }
+}
+
+TEST_P(SimplifyBackendTest, ClosedRingMatchesScalar) {
+    // First == last, so the top-level chord is degenerate. Radii are jittered
+    // so no two candidates tie exactly.
+    PolylineSoA ring;
+    for (int i = 0; i < 37; ++i) {
+        double angle = 2.0 * M_PI * i / 36.0;
+        double radius = 10.0 + 0.3 * ((i * 7) % 5) + 0.01 * i;
+        ring.push_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+    ring.x.back() = ring.x.front();
+    ring.y.back() = ring.y.front();
+
+    auto expected = simplify(ring, 0.5, SimplifyAlgorithm::SCALAR);
+    auto actual = simplify(ring, 0.5, GetParam());
+    EXPECT_GT(actual.size(), 2);
+    EXPECT_TRUE(polylines_equal(expected, actual));
+}
+
+TEST_P(SimplifyBackendTest, ArgmaxUsesUndividedKey) {
+    // Both interior points divide to the same squared distance over the
+    // chord, but the second has the larger cross^2. Every back end must
+    // keep it; ranking on the quotient would keep the first.
+    PolylineSoA line;
+    line.push_back(0.0, 0.0);
+    line.push_back(37.0, 15.000000000000007);
+    line.push_back(37.0, 15.0);
+    line.push_back(9.0, 14.0);
+
+    for (auto algorithm : {SimplifyAlgorithm::SCALAR, GetParam()}) {
+        auto result = simplify(line, 1.0, algorithm);
+        ASSERT_EQ(result.size(), 3);
+        EXPECT_EQ(result.y[1], 15.0);
+    }
+}
+
+TEST_P(SimplifyBackendTest, DeepSplitKeepsEveryPoint) {
+    // Zigzag with growing amplitude: every split peels off the second-to-last
+    // point, so the old recursion would go ~n frames deep
+    PolylineSoA zigzag;
+    for (int i = 0; i < 5000; ++i) {
+        zigzag.push_back(i, (i % 2 == 0) ? i : -i);
+    }
+
+    auto result = simplify(zigzag, 1.0, GetParam());
+    EXPECT_TRUE(polylines_equal(result, zigzag));
+}
+
+TEST_P(SimplifyBackendTest, IndicesAndMaskMatchSimplify) {
+    auto line = create_random_walk(1000, 7);
+    auto simplified = simplify(line, 0.5, GetParam());
+    auto indices = simplify_indices(line, 0.5, GetParam());
+    auto mask = simplify_mask(line, 0.5, GetParam());
+
+    ASSERT_EQ(indices.size(), simplified.size());
+    ASSERT_EQ(mask.size(), (line.size() + 63) / 64);
+
+    size_t next = 0;
+    for (size_t i = 0; i < line.size(); ++i) {
+        bool kept = (mask[i / 64] >> (i % 64)) & 1;
+        bool listed = next < indices.size() && indices[next] == i;
+        EXPECT_EQ(kept, listed) << "vertex " << i;
+        if (listed) {
+            EXPECT_TRUE(points_equal(line[i].x, line[i].y,
+                                     simplified[next].x, simplified[next].y));
+            ++next;
+        }
+    }
+    EXPECT_EQ(next, indices.size());
+}
+
+TEST_P(SimplifyBackendTest, ParallelMatchesSerial) {
+    auto line = create_random_walk(200000, 3);
+    auto expected = simplify(line, 0.5, GetParam());
+
+    SimplifyOptions options;
+    options.algorithm = GetParam();
+    options.execution = SimplifyExecution::PARALLEL;
+    options.parallel_threshold = 64;  // force lots of small tasks
+
+    // 1000 is clamped to the hardware thread count
+    for (size_t threads : {1, 2, 4, 1000}) {
+        options.num_threads = threads;
+        auto actual = simplify(line, 0.5, options);
+        EXPECT_TRUE(polylines_equal(expected, actual)) << "threads=" << threads;
+    }
+}
+
+TEST_P(SimplifyBackendTest, BreadthFirstMatchesSerial) {
+    SimplifyOptions options;
+    options.algorithm = GetParam();
+    options.execution = SimplifyExecution::BREADTH_FIRST;
+
+    // Mix of lengths so levels hold both packed and stand-alone segments
+    for (size_t n : {3, 9, 100, 1000, 50000}) {
+        auto line = create_random_walk(n, static_cast<unsigned>(n) + 7);
+        for (double tolerance : {0.05, 0.5, 2.0}) {
+            auto expected = simplify(line, tolerance, GetParam());
+            auto actual = simplify(line, tolerance, options);
+            EXPECT_TRUE(polylines_equal(expected, actual))
+                << "n=" << n << " tolerance=" << tolerance;
+        }
+    }
+
+    // Closed ring: degenerate chord at the top level
+    PolylineSoA ring;
+    for (int i = 0; i <= 40; ++i) {
+        double angle = 2.0 * M_PI * (i % 40) / 40.0;
+        ring.push_back(std::cos(angle) * 10.0, std::sin(angle) * 10.0);
+    }
+    EXPECT_TRUE(polylines_equal(simplify(ring, 0.1, GetParam()), simplify(ring, 0.1, options)));
+}
+
+TEST_P(SimplifyBackendTest, SignificanceMatchesSimplify) {
+    for (size_t n : {3, 10, 1000, 4099}) {
+        auto line = create_random_walk(n, static_cast<unsigned>(n) + 11);
+        auto significance = simplify_significance(line, GetParam());
+        ASSERT_EQ(significance.size(), line.size());
+
+        PolylineSoA extracted;
+        for (double tolerance : {0.05, 0.1, 0.5, 1.0, 2.0, 8.0, 100.0}) {
+            simplify_by_significance(line, significance, tolerance, extracted, GetParam());
+            auto expected = simplify(line, tolerance, GetParam());
+            EXPECT_TRUE(polylines_equal(expected, extracted))
+                << "n=" << n << " tolerance=" << tolerance;
+        }
+    }
+}
+
+TEST_P(SimplifyBackendTest, VisvalingamMatchesReference) {
+    for (size_t n : {3, 4, 9, 10, 17, 257, 2000}) {
+        auto line = create_random_walk(n, static_cast<unsigned>(n) + 5);
+        for (double area_tolerance : {0.01, 0.5, 2.0, 50.0}) {
+            auto expected = reference_vw(line, area_tolerance);
+            auto actual = simplify_vw(line, area_tolerance, GetParam());
+            EXPECT_TRUE(polylines_equal(expected, actual))
+                << "n=" << n << " area_tolerance=" << area_tolerance;
+        }
+    }
+}
+
+TEST_P(SimplifyBackendTest, VisvalingamBreaksAreaTiesByVertex) {
+    // Integer grid: every area is a multiple of 0.5, so most heap entries
+    // tie on area and only the vertex order decides what goes first
+    for (size_t n : {9, 64, 257, 2000}) {
+        PolylineSoA line;
+        unsigned state = static_cast<unsigned>(n) + 41;
+        for (size_t i = 0; i < n; ++i) {
+            state = state * 1664525u + 1013904223u;
+            line.push_back(static_cast<double>(i), static_cast<double>((state >> 16) % 3));
+        }
+        for (double area_tolerance : {0.75, 1.25, 2.25, 4.0}) {
+            auto expected = reference_vw(line, area_tolerance);
+            auto actual = simplify_vw(line, area_tolerance, GetParam());
+            EXPECT_TRUE(polylines_equal(expected, actual))
+                << "n=" << n << " area_tolerance=" << area_tolerance;
+        }
+    }
+}
+
+TEST_P(SimplifyBackendTest, RadialPrefilterMatchesReference) {
+    SimplifyOptions options;
+    options.algorithm = GetParam();
+    options.radial_prefilter = true;
+
+    for (size_t n : {3, 4, 5, 9, 10, 17, 1000, 4099}) {
+        // Dense walk: steps well under the tolerances below give long runs
+        // of dropped points, the coarse ones give runs of kept points
+        auto line = create_random_walk(n, static_cast<unsigned>(n) + 23);
+        for (size_t i = 0; i < n; ++i) {
+            line.x[i] *= (i / 16) % 2 ? 0.05 : 1.0;
+        }
+
+        for (double tolerance : {0.01, 0.3, 1.0, 3.0, 50.0}) {
+            // Radial pre-pass, one point at a time, then plain Douglas-Peucker
+            PolylineSoA filtered;
+            filtered.push_back(line.x[0], line.y[0]);
+            size_t key = 0;
+            for (size_t i = 1; i < n; ++i) {
+                double dx = line.x[i] - line.x[key];
+                double dy = line.y[i] - line.y[key];
+                if (dx * dx + dy * dy > tolerance * tolerance) {
+                    filtered.push_back(line.x[i], line.y[i]);
+                    key = i;
+                }
+            }
+            if (key != n - 1) {
+                filtered.push_back(line.x[n - 1], line.y[n - 1]);
+            }
+
+            auto expected = simplify(filtered, tolerance, SimplifyAlgorithm::SCALAR);
+            auto actual = simplify(line, tolerance, options);
+            EXPECT_TRUE(polylines_equal(expected, actual))
+                << "n=" << n << " tolerance=" << tolerance;
+        }
+    }
+}
+
+TEST_P(SimplifyBackendTest, Float32MatchesScalar) {
+    for (size_t n : {3, 4, 5, 9, 16, 17, 18, 33, 100, 1000, 4099}) {
+        auto walk = create_random_walk(n, static_cast<unsigned>(n) + 31);
+        PolylineSoAf line;
+        for (size_t i = 0; i < n; ++i) {
+            line.push_back(static_cast<float>(walk.x[i]), static_cast<float>(walk.y[i]));
+        }
+
+        for (double tolerance : {0.1, 0.5, 2.0}) {
+            auto expected = simplify(line, tolerance, SimplifyAlgorithm::SCALAR);
+            auto actual = simplify(line, tolerance, GetParam());
+            EXPECT_EQ(expected.x, actual.x) << "n=" << n << " tolerance=" << tolerance;
+            EXPECT_EQ(expected.y, actual.y) << "n=" << n << " tolerance=" << tolerance;
+        }
+    }
+}
+
+TEST_P(SimplifyBackendTest, FixedPointMatchesScalar) {
+    for (size_t n : {3, 4, 5, 8, 9, 10, 17, 100, 1000, 4099}) {
+        auto walk = create_random_walk(n, static_cast<unsigned>(n) + 37);
+        PolylineSoAi line;
+        for (size_t i = 0; i < n; ++i) {
+            line.push_back(static_cast<int32_t>(std::lround(walk.x[i] * 16)),
+                           static_cast<int32_t>(std::lround(walk.y[i] * 16)));
+        }
+        PolylineSoAi ring = line;
+        ring.push_back(line.x[0], line.y[0]);
+
+        for (double tolerance : {1.0, 8.0, 32.0}) {
+            for (const PolylineSoAi* input : {&line, &ring}) {
+                auto expected = simplify(*input, tolerance, SimplifyAlgorithm::SCALAR);
+                auto actual = simplify(*input, tolerance, GetParam());
+                EXPECT_EQ(expected.x, actual.x) << "n=" << n << " tolerance=" << tolerance;
+                EXPECT_EQ(expected.y, actual.y) << "n=" << n << " tolerance=" << tolerance;
+            }
+        }
+    }
+}
+
+// The AVX2 and AVX-512 scans walk aligned blocks and mask the lanes before
+// start and past end. A spike at an odd offset makes the second scan start
+// there, over ranges sized right at the 4, 8 and 16 lane block boundaries.
+TEST_P(SimplifyBackendTest, ScansAtOddOffsetsAndBlockBoundaries) {
+    unsigned state = 17;
+    auto noise = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<double>(state >> 8) / static_cast<double>(1u << 24) - 0.5;
+    };
+    
+    for (size_t offset : {1, 3, 5, 7, 9, 15, 17}) {
+        for (size_t size : {2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65}) {
+            PolylineSoA line;
+            PolylineSoAf line_f;
+            for (size_t i = 0; i <= offset + size; ++i) {
+                double y = i == offset ? 1000.0 : 4.0 * noise();
+                line.push_back(static_cast<double>(i), y);
+                line_f.push_back(static_cast<float>(i), static_cast<float>(y));
+            }
+            
+            for (double tolerance : {0.1, 1.0}) {
+                EXPECT_TRUE(polylines_equal(simplify(line, tolerance, SimplifyAlgorithm::SCALAR),
+                                            simplify(line, tolerance, GetParam())))
+                    << "offset=" << offset << " size=" << size << " tolerance=" << tolerance;
+                auto expected_f = simplify(line_f, tolerance, SimplifyAlgorithm::SCALAR);
+                auto actual_f = simplify(line_f, tolerance, GetParam());
+                EXPECT_EQ(expected_f.x, actual_f.x) << "offset=" << offset << " size=" << size;
+                EXPECT_EQ(expected_f.y, actual_f.y) << "offset=" << offset << " size=" << size;
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Scalar, SimplifyBackendTest,
+                         ::testing::Values(SimplifyAlgorithm::SCALAR));
+
+INSTANTIATE_TEST_SUITE_P(Sse2, SimplifyBackendTest,
+                         ::testing::Values(SimplifyAlgorithm::SSE2));
+
+INSTANTIATE_TEST_SUITE_P(Avx2, SimplifyBackendTest,
+                         ::testing::Values(SimplifyAlgorithm::AVX2));
+
+INSTANTIATE_TEST_SUITE_P(Avx512, SimplifyBackendTest,
+                         ::testing::Values(SimplifyAlgorithm::AVX512));
+
 // Parameterized test for different tolerances
 class SimplifyToleranceTest : public SimplifyTest,
                                public ::testing::WithParamInterface<double> {};
@@ -195,3 +591,251 @@ INSTANTIATE_TEST_SUITE_P(
     SimplifyToleranceTest,
     ::testing::Values(0.01, 0.1, 1.0, 5.0, 10.0)
 );
+
+TEST_F(SimplifyTest, SimplifyIntoMatchesSimplify) {
+    auto line = create_test_line();
+    auto expected = simplify(line, 1.0);
+    
+    PolylineSoA output;
+    SimplifyScratch scratch;
+    simplify_into(line, 1.0, output, scratch);
+    EXPECT_TRUE(polylines_equal(output, expected));
+}
+
+TEST_F(SimplifyTest, SimplifyIntoReusesBuffers) {
+    PolylineSoA output;
+    SimplifyScratch scratch;
+    
+    // Big input first so the buffers are already large enough afterwards
+    auto zigzag = create_zigzag();
+    simplify_into(zigzag, 0.1, output, scratch);
+    EXPECT_TRUE(polylines_equal(output, simplify(zigzag, 0.1)));
+    
+    const double* x_data = output.x.data();
+    
+    // Smaller input: stale contents must not leak into the result
+    auto line = create_test_line();
+    simplify_into(line, 1.0, output, scratch);
+    EXPECT_TRUE(polylines_equal(output, simplify(line, 1.0)));
+    EXPECT_EQ(output.x.data(), x_data);
+    
+    PolylineSoA two = {{0, 0}, {10, 10}};
+    simplify_into(two, 1.0, output, scratch);
+    EXPECT_TRUE(polylines_equal(output, two));
+}
+
+TEST_F(SimplifyTest, BreadthFirstSimplifyIntoReusesScratch) {
+    SimplifyOptions options;
+    options.execution = SimplifyExecution::BREADTH_FIRST;
+    PolylineSoA output;
+    SimplifyScratch scratch;
+
+    auto big = create_random_walk(50000, 3);
+    simplify_into(big, 0.05, output, scratch, options);
+
+    const void* blocks = scratch.blocks.data();
+    const void* farthest = scratch.farthest.data();
+    const void* lanes = scratch.lane_key.data();
+    std::set<const void*> levels = {scratch.level.data(), scratch.next_level.data()};
+
+    // Levels swap every sweep, so only the pair of buffers is stable
+    auto line = create_random_walk(5000, 4);
+    simplify_into(line, 0.05, output, scratch, options);
+    EXPECT_TRUE(polylines_equal(output, simplify(line, 0.05)));
+    EXPECT_EQ(scratch.blocks.data(), blocks);
+    EXPECT_EQ(scratch.farthest.data(), farthest);
+    EXPECT_EQ(scratch.lane_key.data(), lanes);
+    EXPECT_EQ((std::set<const void*>{scratch.level.data(), scratch.next_level.data()}), levels);
+}
+
+TEST_F(SimplifyTest, SimplifyIntoInvalidTolerance) {
+    auto line = create_test_line();
+    PolylineSoA output;
+    SimplifyScratch scratch;
+    EXPECT_THROW(simplify_into(line, 0.0, output, scratch), std::invalid_argument);
+}
+
+TEST_F(SimplifyTest, IndicesTrivialLines) {
+    PolylineSoA empty;
+    EXPECT_TRUE(simplify_indices(empty, 1.0).empty());
+    EXPECT_TRUE(simplify_mask(empty, 1.0).empty());
+    
+    PolylineSoA two = {{0, 0}, {10, 10}};
+    EXPECT_EQ(simplify_indices(two, 1.0), (std::vector<size_t>{0, 1}));
+    EXPECT_EQ(simplify_mask(two, 1.0), (std::vector<uint64_t>{0x3}));
+}
+
+TEST_F(SimplifyTest, IndicesStraightLine) {
+    PolylineSoA straight = {{0, 0}, {1, 1}, {2, 2}, {3, 3}, {4, 4}};
+    EXPECT_EQ(simplify_indices(straight, 0.01), (std::vector<size_t>{0, 4}));
+    EXPECT_THROW(simplify_indices(straight, 0.0), std::invalid_argument);
+}
+
+TEST(SimplifyBatchTest, MatchesPerLineSimplify) {
+    // Mixed sizes, including trivial lines and a few big ones
+    std::vector<PolylineSoA> lines;
+    for (size_t i = 0; i < 300; ++i) {
+        size_t n = (i % 50 == 0) ? 20000 : i % 37;
+        lines.push_back(create_random_walk(n, static_cast<unsigned>(i)));
+    }
+    
+    // 1000 is clamped to the hardware thread count
+    for (size_t threads : {1, 2, 4, 1000}) {
+        std::vector<PolylineSoA> outputs;
+        simplify_batch(lines, outputs, 0.5, SimplifyAlgorithm::AUTO, threads);
+        
+        ASSERT_EQ(outputs.size(), lines.size());
+        for (size_t i = 0; i < lines.size(); ++i) {
+            EXPECT_TRUE(polylines_equal(outputs[i], simplify(lines[i], 0.5)))
+                << "line " << i << " threads=" << threads;
+        }
+    }
+}
+
+TEST(SimplifyBatchTest, EmptyBatchAndInvalidTolerance) {
+    std::vector<PolylineSoA> lines;
+    std::vector<PolylineSoA> outputs;
+    simplify_batch(lines, outputs, 1.0);
+    EXPECT_TRUE(outputs.empty());
+    
+    lines.push_back(create_random_walk(100, 1));
+    EXPECT_THROW(simplify_batch(lines, outputs, 0.0, SimplifyAlgorithm::AUTO, 2),
+                 std::invalid_argument);
+}
+
+TEST_F(SimplifyTest, SignificanceIsMonotoneAndClamped) {
+    auto line = create_test_line();
+    auto significance = simplify_significance(line);
+    
+    ASSERT_EQ(significance.size(), line.size());
+    EXPECT_TRUE(std::isinf(significance.front()));
+    EXPECT_TRUE(std::isinf(significance.back()));
+    
+    // Keep sets shrink as the tolerance grows
+    PolylineSoA previous = line;
+    for (double tolerance : {0.01, 0.1, 1.0, 5.0, 10.0}) {
+        PolylineSoA extracted;
+        simplify_by_significance(line, significance, tolerance, extracted);
+        EXPECT_LE(extracted.size(), previous.size());
+        EXPECT_TRUE(polylines_equal(extracted, simplify(line, tolerance)));
+        previous = extracted;
+    }
+    
+    PolylineSoA straight = {{0, 0}, {1, 1}, {2, 2}};
+    auto flat = simplify_significance(straight);
+    EXPECT_DOUBLE_EQ(flat[1], 0.0);
+    
+    std::vector<double> wrong_size(2, 1.0);
+    PolylineSoA output;
+    EXPECT_THROW(simplify_by_significance(line, wrong_size, 1.0, output), std::invalid_argument);
+}
+
+TEST_F(SimplifyTest, VisvalingamBasics) {
+    PolylineSoA two = {{0, 0}, {1, 1}};
+    EXPECT_TRUE(polylines_equal(simplify_vw(two, 1.0), two));
+    EXPECT_THROW(simplify_vw(create_test_line(), 0.0), std::invalid_argument);
+    
+    // Collinear points have zero area and always go
+    PolylineSoA straight = {{0, 0}, {1, 1}, {2, 2}, {3, 3}};
+    auto result = simplify_vw(straight, 1e-9);
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_TRUE(points_equal(result[1].x, result[1].y, 3, 3));
+    
+    // The spike's triangle has area ~5, the bumps next to it ~2.5
+    PolylineSoA spike = {{0, 0}, {1, 0.01}, {2, 5}, {3, 0.01}, {4, 0}};
+    result = simplify_vw(spike, 3.0);
+    ASSERT_EQ(result.size(), 3);
+    EXPECT_TRUE(points_equal(result[1].x, result[1].y, 2, 5));
+}
+
+TEST_F(SimplifyTest, VisvalingamKeepSetsAreNested) {
+    auto line = create_random_walk(500, 42);
+    PolylineSoA previous = line;
+    for (double area_tolerance : {0.1, 1.0, 5.0, 25.0, 100.0}) {
+        auto result = simplify_vw(line, area_tolerance);
+        ASSERT_LE(result.size(), previous.size());
+        
+        // Every surviving point also survived the smaller tolerance
+        size_t j = 0;
+        for (size_t i = 0; i < result.size(); ++i) {
+            while (j < previous.size() && previous.x[j] != result.x[i]) {
+                ++j;
+            }
+            ASSERT_LT(j, previous.size()) << "area_tolerance=" << area_tolerance;
+        }
+        previous = result;
+    }
+}
+
+TEST_F(SimplifyTest, RadialPrefilterCollapsesDuplicates) {
+    // Runs of repeated points at the corners of a square
+    PolylineSoA line;
+    for (auto corner : {std::pair<double, double>{0, 0}, {10, 0}, {10, 10}, {0, 10}}) {
+        for (int i = 0; i < 50; ++i) {
+            line.push_back(corner.first + 1e-3 * i, corner.second);
+        }
+    }
+
+    SimplifyOptions options;
+    options.radial_prefilter = true;
+    auto result = simplify(line, 0.5, options);
+
+    // The last run ends on the line's last point, which is always kept and
+    // takes over from the first point of its run
+    ASSERT_EQ(result.size(), 4u);
+    EXPECT_TRUE(points_equal(result.x[0], result.y[0], 0, 0));
+    EXPECT_TRUE(points_equal(result.x[1], result.y[1], 10, 0));
+    EXPECT_TRUE(points_equal(result.x[2], result.y[2], 10, 10));
+    EXPECT_TRUE(points_equal(result.x[3], result.y[3], line.x.back(), line.y.back()));
+}
+
+TEST_F(SimplifyTest, Float32MatchesDoubleOnSmallIntegers) {
+    // Small integer coordinates make every key exact in float and double
+    PolylineSoA line;
+    PolylineSoAf line_f;
+    unsigned state = 7;
+    for (int i = 0; i < 500; ++i) {
+        state = state * 1664525u + 1013904223u;
+        int y = static_cast<int>((state >> 16) % 9);
+        line.push_back(i % 64, y);
+        line_f.push_back(static_cast<float>(i % 64), static_cast<float>(y));
+    }
+
+    for (double tolerance : {0.3, 1.7, 3.3}) {
+        auto expected = simplify(line, tolerance);
+        auto actual = simplify(line_f, tolerance);
+        ASSERT_EQ(expected.size(), actual.size()) << "tolerance=" << tolerance;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(expected.x[i], actual.x[i]);
+            EXPECT_EQ(expected.y[i], actual.y[i]);
+        }
+    }
+
+    PolylineSoAf out;
+    SimplifyScratch scratch;
+    EXPECT_THROW(simplify_into(line_f, 0.0, out, scratch), std::invalid_argument);
+}
+
+TEST_F(SimplifyTest, FixedPointMatchesDouble) {
+    // Tile-grid coordinates are exact in double too, so the keep sets agree
+    PolylineSoA line;
+    PolylineSoAi line_i;
+    unsigned state = 11;
+    for (int i = 0; i < 1000; ++i) {
+        state = state * 1664525u + 1013904223u;
+        int32_t x = 4 * i;
+        int32_t y = 2000 + static_cast<int32_t>((state >> 16) % 64);
+        line.push_back(x, y);
+        line_i.push_back(x, y);
+    }
+
+    for (double tolerance : {0.5, 5.5, 20.5}) {
+        auto expected = simplify(line, tolerance);
+        auto actual = simplify(line_i, tolerance);
+        ASSERT_EQ(expected.size(), actual.size()) << "tolerance=" << tolerance;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(expected.x[i], actual.x[i]);
+            EXPECT_EQ(expected.y[i], actual.y[i]);
+        }
+    }
+}
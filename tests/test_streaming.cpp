@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include "geom_simd/streaming.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace geom;
+
+namespace {
+
+PolylineSoA create_trace(size_t n, unsigned seed) {
+    unsigned state = seed;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<double>(state >> 8) / static_cast<double>(1u << 24) - 0.5;
+    };
+
+    // Vehicle-like: mostly straight runs with occasional turns and jitter
+    PolylineSoA trace;
+    double x = 0.0, y = 0.0, heading = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        if (i % 40 == 0) {
+            heading += 2.0 * next();
+        }
+        x += std::cos(heading) + 0.05 * next();
+        y += std::sin(heading) + 0.05 * next();
+        trace.push_back(x, y);
+    }
+    return trace;
+}
+
+PolylineSoA stream_point_by_point(const PolylineSoA& trace, double tolerance,
+                                  SimplifyAlgorithm algorithm = SimplifyAlgorithm::AUTO) {
+    StreamingSimplifier simplifier(tolerance, algorithm);
+    PolylineSoA output;
+    for (size_t i = 0; i < trace.size(); ++i) {
+        simplifier.push(trace.x[i], trace.y[i], output);
+    }
+    simplifier.flush(output);
+    return output;
+}
+
+} // anonymous namespace
+
+TEST(StreamingTest, KeepsCornersOfAnL) {
+    PolylineSoA trace = {{0, 0}, {1, 0}, {2, 0}, {2, 1}, {2, 2}};
+    StreamingSimplifier simplifier(0.1);
+    PolylineSoA output;
+
+    EXPECT_EQ(simplifier.push(0, 0, output), 1);  // First point right away
+    EXPECT_EQ(simplifier.push(1, 0, output), 0);
+    EXPECT_EQ(simplifier.push(2, 0, output), 0);
+    EXPECT_EQ(simplifier.push(2, 1, output), 1);  // Corner known once we turn
+    EXPECT_EQ(output.size(), 2);
+    EXPECT_EQ(output.x[1], 2.0);
+    EXPECT_EQ(output.y[1], 0.0);
+
+    EXPECT_EQ(simplifier.push(2, 2, output), 0);
+    EXPECT_EQ(simplifier.flush(output), 1);
+    ASSERT_EQ(output.size(), 3);
+    EXPECT_EQ(output.x[2], 2.0);
+    EXPECT_EQ(output.y[2], 2.0);
+}
+
+TEST(StreamingTest, TrivialTraces) {
+    StreamingSimplifier simplifier(1.0);
+    PolylineSoA output;
+    EXPECT_EQ(simplifier.flush(output), 0);
+    EXPECT_TRUE(output.empty());
+
+    simplifier.push(3, 4, output);
+    simplifier.flush(output);
+    ASSERT_EQ(output.size(), 1);
+
+    // Repeats of the first point collapse into it
+    output.clear();
+    simplifier.push(1, 1, output);
+    simplifier.push(1, 1, output);
+    simplifier.push(1, 1, output);
+    simplifier.flush(output);
+    EXPECT_EQ(output.size(), 1);
+
+    EXPECT_THROW(StreamingSimplifier(0.0), std::invalid_argument);
+    EXPECT_THROW(StreamingSimplifier(-1.0), std::invalid_argument);
+}
+
+TEST(StreamingTest, KeepsEndpointsAndDropsWithinTolerance) {
+    auto trace = create_trace(5000, 7);
+    auto output = stream_point_by_point(trace, 0.5);
+
+    ASSERT_GE(output.size(), 2);
+    EXPECT_LT(output.size(), trace.size() / 4);
+    EXPECT_EQ(output.x.front(), trace.x.front());
+    EXPECT_EQ(output.y.back(), trace.y.back());
+
+    // Output is a subsequence of the input
+    size_t j = 0;
+    for (size_t i = 0; i < output.size(); ++i) {
+        while (j < trace.size() && (trace.x[j] != output.x[i] || trace.y[j] != output.y[i])) {
+            ++j;
+        }
+        ASSERT_LT(j, trace.size()) << "vertex " << i;
+    }
+}
+
+TEST(StreamingTest, FlushResetsForNextTrace) {
+    auto first = create_trace(300, 1);
+    auto second = create_trace(300, 2);
+
+    StreamingSimplifier simplifier(0.5);
+    PolylineSoA output;
+    simplifier.push_many(first.x.data(), first.y.data(), first.size(), output);
+    simplifier.flush(output);
+
+    output.clear();
+    simplifier.push_many(second.x.data(), second.y.data(), second.size(), output);
+    simplifier.flush(output);
+    EXPECT_EQ(output.x, stream_point_by_point(second, 0.5).x);
+}
+
+class StreamingBackendTest : public ::testing::TestWithParam<SimplifyAlgorithm> {
+protected:
+    void SetUp() override {
+        auto caps = get_simd_capabilities();
+        if ((GetParam() == SimplifyAlgorithm::SSE2 && !caps.sse2_available) ||
+            (GetParam() == SimplifyAlgorithm::AVX2 && !caps.avx2_available) ||
+            (GetParam() == SimplifyAlgorithm::AVX512 && !caps.avx512_available)) {
+            GTEST_SKIP() << "ISA not available on this CPU";
+        }
+    }
+};
+
+TEST_P(StreamingBackendTest, PushManyMatchesPush) {
+    for (double tolerance : {0.05, 0.5, 3.0}) {
+        auto trace = create_trace(4000, 11);
+        auto expected = stream_point_by_point(trace, tolerance, SimplifyAlgorithm::SCALAR);
+
+        for (size_t chunk : {1, 3, 8, 61, 4000}) {
+            StreamingSimplifier simplifier(tolerance, GetParam());
+            PolylineSoA output;
+            for (size_t i = 0; i < trace.size(); i += chunk) {
+                size_t count = std::min(chunk, trace.size() - i);
+                simplifier.push_many(&trace.x[i], &trace.y[i], count, output);
+            }
+            simplifier.flush(output);
+
+            EXPECT_EQ(output.x, expected.x) << "tolerance=" << tolerance << " chunk=" << chunk;
+            EXPECT_EQ(output.y, expected.y) << "tolerance=" << tolerance << " chunk=" << chunk;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Scalar, StreamingBackendTest,
+                         ::testing::Values(SimplifyAlgorithm::SCALAR));
+
+INSTANTIATE_TEST_SUITE_P(Sse2, StreamingBackendTest,
+                         ::testing::Values(SimplifyAlgorithm::SSE2));
+
+INSTANTIATE_TEST_SUITE_P(Avx2, StreamingBackendTest,
+                         ::testing::Values(SimplifyAlgorithm::AVX2));
+
+INSTANTIATE_TEST_SUITE_P(Avx512, StreamingBackendTest,
+                         ::testing::Values(SimplifyAlgorithm::AVX512));